@@ -0,0 +1 @@
+../src/sat/Portfolio.h
\ No newline at end of file
@@ -0,0 +1 @@
+../src/sat/Simplifier.h
\ No newline at end of file
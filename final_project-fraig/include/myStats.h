@@ -0,0 +1 @@
+../src/util/myStats.h
\ No newline at end of file
@@ -0,0 +1,317 @@
+/****************************************************************************
+  FileName     [ aigGen.cpp ]
+  PackageName  [ aigGen ]
+  Synopsis     [ Synthetic large AIG generator for scalability tests ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <cmath>
+#include "rnGen.h"
+
+using namespace std;
+
+// Synthetic AIG generator for scalability tests. The ANDs are written as they
+// are made, so the memory is a window of the most recent gates (for picking
+// the inputs and the duplicates) and the gates still without a fanout, not
+// the graph.
+//
+// The gates are made in "depth" layers of equal size; a gate has one input in
+// the layer before (or a PI for the first layer), taken in turn so that every
+// gate but the last layer has a fanout, and the other one anywhere in the
+// window, picked by index^skew toward the oldest candidates, so a skew > 1
+// gives a few gates a large fanout; half of those inputs are the oldest gates
+// without a fanout yet (first the ones which left the window without one).
+// In a layer,
+//   - "redundancy" of the gates are planted duplicates of a gate in the layer
+//     before: half structural (the same two inputs), half functional
+//     (g & x for an input x of g, which is g again but not by strashing);
+//   - "xor" of the gates are in XOR blocks (3 ANDs);
+//   - "mult" of the gates are in array multipliers of "width" bits.
+// At the end, the gates left without a fanout are ANDed in pairs (with random
+// inversions) until "pos" of them are left, they are the POs, so no gate is
+// dangling; this adds one AND per gate left over to the "ands" of the layers.
+// The generation runs twice with the same seed: the first run only counts the
+// ANDs and picks the POs (the header and the POs come before the ANDs).
+
+struct GenParam
+{
+   unsigned long long ands = 1000000;
+   unsigned pis = 64;
+   unsigned pos = 64;
+   unsigned depth = 64;
+   double skew = 1.0;
+   double redundancy = 0;
+   double xorRatio = 0;
+   double multRatio = 0;
+   unsigned width = 8;
+   unsigned seed = 0;
+   bool binary = false;
+};
+
+static const size_t GEN_WINDOW = 1 << 22;  // gates kept for picking inputs and duplicates
+
+class AigGen
+{
+public:
+   AigGen(const GenParam& p, FILE* out): _p(p), _out(out), _rn(p.seed) {
+      _window.resize(min((unsigned long long)GEN_WINDOW, max(p.ands, 1ULL)));
+      _used.resize(_window.size());
+      _buf.reserve(1 << 16);
+      // the ratios are of the gates, so a block type is picked by ratio / size
+      double multSize = p.width * p.width + (p.width - 1) * (4 + 9.0 * (p.width - 1));
+      double wMult = p.multRatio / multSize, wXor = p.xorRatio / 3, wDup = p.redundancy;
+      double total = wMult + wXor + wDup + (1 - p.multRatio - p.xorRatio - p.redundancy);
+      _pMult = wMult / total;
+      _pXor = _pMult + wXor / total;
+      _pDup = _pXor + wDup / total;
+   }
+
+   // make all the gates, write the ANDs if "_out" is not NULL
+   void run() {
+      _next = _p.pis + 1;
+      unsigned long long layerSize = max(1ULL, _p.ands / _p.depth);
+      _prevBegin = _prevEnd = 0;  // (the PIs for the first layer)
+      while (made() < _p.ands) {
+         unsigned long long layerBegin = _next;
+         _turn = 0;
+         unsigned long long target = min(_p.ands, made() + layerSize);
+         while (made() < target) {
+            double u = uniform();
+            if (u < _pMult) multiplier();
+            else if (u < _pXor) xorBlock(pick(true), pick(false));
+            else if (u < _pDup && _prevEnd > _prevBegin) duplicate();
+            else newAnd(pick(true), pick(false));
+         }
+         _prevBegin = layerBegin;
+         _prevEnd = _next;
+      }
+      // AND the pairs of gates without fanout, "pos" literals are left
+      _outs.clear();
+      while (hasUnused() && _evicted.size() + _unused.size() + _outs.size() > _p.pos) {
+         unsigned long long a = popUnused();
+         if (!hasUnused()) { _outs.push_back(a); break; }
+         unsigned long long b = popUnused();
+         newAnd(a ^ (_rn.next() & 1), b ^ (_rn.next() & 1));
+      }
+      while (hasUnused()) _outs.push_back(popUnused());
+      flush();
+   }
+   unsigned long long made() const { return _next - _p.pis - 1; }
+   // POs: the literals left by run(), then PIs if there are not enough
+   void pickOutputs(vector<unsigned long long>& outs) {
+      outs = _outs;
+      for (unsigned i = outs.size(); i < _p.pos; ++i)
+         outs.push_back(2 * (1 + _rn.next() % _p.pis));
+   }
+
+private:
+   GenParam                _p;
+   FILE*                   _out;
+   RandomNumGen            _rn;
+   unsigned long long      _next;       // variable id of the next AND
+   unsigned long long      _prevBegin;  // [begin, end) of the layer before
+   unsigned long long      _prevEnd;
+   unsigned long long      _turn;       // next input taken from the layer before
+   double                  _pMult;      // cumulative probabilities of the block types
+   double                  _pXor;
+   double                  _pDup;
+   vector<pair<unsigned long long, unsigned long long> > _window;  // inputs of gate id % size
+   vector<bool>            _used;       // gate id % size has a fanout
+   deque<unsigned long long> _unused;   // literals of the gates without fanout, oldest first
+   deque<unsigned long long> _evicted;  // the same, of the gates out of the window
+   vector<unsigned long long> _outs;
+   string                  _buf;
+
+   double uniform() { return (_rn.next() >> 11) * (1.0 / 9007199254740992.0); }
+
+   // the oldest gate in the window
+   unsigned long long windowBegin() const {
+      return _next > _window.size() + _p.pis + 1 ? _next - _window.size() : _p.pis + 1;
+   }
+   // a literal of the layer before (if "prev", in turn) or of any gate in the window; a PI
+   // for the first layer, otherwise by the share of the PIs in the candidates
+   unsigned long long pick(bool prev) {
+      unsigned long long begin = windowBegin(), end = _next;
+      if (prev) { begin = max(_prevBegin, begin); end = _prevEnd; }
+      if (begin >= end || (!prev && uniform() * (end - begin + _p.pis) < _p.pis))
+         return 2 * (1 + _rn.next() % _p.pis) + (_rn.next() & 1);
+      if (!prev && (_rn.next() & 1) && hasUnused())
+         return popUnused() ^ (_rn.next() & 1);
+      unsigned long long n = end - begin;
+      unsigned long long i = prev ? _turn++ % n : (unsigned long long)(n * pow(uniform(), _p.skew));
+      return 2 * (begin + min(i, n - 1)) + (_rn.next() & 1);
+   }
+
+   bool hasUnused() const { return !_evicted.empty() || !_unused.empty(); }
+   // the oldest gate without fanout (there must be one)
+   unsigned long long popUnused() {
+      deque<unsigned long long>& q = _evicted.empty() ? _unused : _evicted;
+      unsigned long long lit = q.front();
+      q.pop_front();
+      cleanUnused();
+      return lit;
+   }
+   // drop the front entries which have a fanout now
+   void cleanUnused() {
+      while (!_unused.empty() && _used[_unused.front() / 2 % _window.size()])
+         _unused.pop_front();
+   }
+   // gate "id" leaves the window: its "_used" flag is reused, so it is moved
+   // to "_evicted" if it has no fanout (it can only get one from there)
+   void evict(unsigned long long id) {
+      while (!_unused.empty() && _unused.front() / 2 <= id) {
+         unsigned long long lit = _unused.front();
+         _unused.pop_front();
+         if (!_used[lit / 2 % _window.size()]) _evicted.push_back(lit);
+      }
+   }
+   void setUsed(unsigned long long lit) {
+      if (lit / 2 > _p.pis && lit / 2 >= windowBegin()) _used[lit / 2 % _window.size()] = true;
+   }
+   unsigned long long newAnd(unsigned long long a, unsigned long long b) {
+      if (a < b) swap(a, b);
+      setUsed(a);
+      setUsed(b);
+      unsigned long long id = _next++;
+      if (id >= _window.size() + _p.pis + 1) evict(id - _window.size());
+      _window[id % _window.size()] = make_pair(a, b);
+      _used[id % _window.size()] = false;
+      _unused.push_back(2 * id);
+      cleanUnused();
+      if (_out) writeAnd(2 * id, a, b);
+      return 2 * id;
+   }
+   void duplicate() {
+      unsigned long long begin = max(_prevBegin, windowBegin());
+      if (begin >= _prevEnd) { newAnd(pick(true), pick(false)); return; }
+      unsigned long long g = begin + _rn.next() % (_prevEnd - begin);
+      const pair<unsigned long long, unsigned long long>& in = _window[g % _window.size()];
+      if (_rn.next() & 1) newAnd(in.first, in.second);
+      else newAnd(2 * g, (_rn.next() & 1) ? in.first : in.second);
+   }
+   unsigned long long andLit(unsigned long long a, unsigned long long b) { return newAnd(a, b); }
+   unsigned long long orLit(unsigned long long a, unsigned long long b) { return newAnd(a ^ 1, b ^ 1) ^ 1; }
+   unsigned long long xorBlock(unsigned long long a, unsigned long long b) {
+      return orLit(andLit(a, b ^ 1), andLit(a ^ 1, b));
+   }
+   // sum and carry of a + b + c
+   void fullAdder(unsigned long long a, unsigned long long b, unsigned long long c,
+                  unsigned long long& sum, unsigned long long& carry) {
+      unsigned long long x = xorBlock(a, b);
+      sum = xorBlock(x, c);
+      carry = orLit(andLit(a, b), andLit(x, c));
+   }
+   // array multiplier: the rows of partial products are added with ripple carry adders
+   void multiplier() {
+      vector<unsigned long long> a(_p.width), b(_p.width), acc, row;
+      for (unsigned i = 0; i < _p.width; ++i) { a[i] = pick(true); b[i] = pick(false); }
+      for (unsigned j = 0; j < _p.width; ++j) acc.push_back(andLit(a[0], b[j]));
+      for (unsigned i = 1; i < _p.width; ++i) {
+         row.clear();
+         for (unsigned j = 0; j < _p.width; ++j) row.push_back(andLit(a[i], b[j]));
+         // acc[i .. i+width-1] += row
+         unsigned long long carry = 0;  // (CONST 0)
+         for (unsigned j = 0; j < _p.width; ++j) {
+            unsigned long long sum;
+            if (i + j < acc.size()) {
+               if (carry == 0) { sum = xorBlock(acc[i + j], row[j]); carry = andLit(acc[i + j], row[j]); }
+               else fullAdder(acc[i + j], row[j], carry, sum, carry);
+               acc[i + j] = sum;
+            }
+            else if (carry == 0) acc.push_back(row[j]);
+            else { acc.push_back(xorBlock(row[j], carry)); carry = andLit(row[j], carry); }
+         }
+         if (carry != 0) acc.push_back(carry);
+      }
+   }
+
+   // ASCII: "lhs rhs0 rhs1"; binary: the two deltas as 7-bit groups
+   void writeAnd(unsigned long long lhs, unsigned long long a, unsigned long long b) {
+      if (_p.binary) { encode(lhs - a); encode(a - b); }
+      else {
+         writeNum(lhs); _buf += ' ';
+         writeNum(a); _buf += ' ';
+         writeNum(b); _buf += '\n';
+      }
+      if (_buf.size() > (1 << 16) - 64) flush();
+   }
+   void writeNum(unsigned long long x) {
+      char tmp[24];
+      int n = 0;
+      do { tmp[n++] = '0' + x % 10; x /= 10; } while (x);
+      while (n) _buf += tmp[--n];
+   }
+   void encode(unsigned long long x) {
+      while (x & ~0x7fULL) { _buf += char((x & 0x7f) | 0x80); x >>= 7; }
+      _buf += char(x);
+   }
+   void flush() {
+      if (_out && !_buf.empty()) fwrite(_buf.data(), 1, _buf.size(), _out);
+      _buf.clear();
+   }
+};
+
+static void
+usage()
+{
+   cerr << "Usage: aigGen [-ands (num)] [-pis (num)] [-pos (num)] [-depth (num)] [-skew (real >= 1)]\n"
+        << "              [-redundancy (ratio)] [-xor (ratio)] [-mult (ratio)] [-width (bits)]\n"
+        << "              [-seed (num)] [-binary] [-o (file)]" << endl;
+}
+
+int
+main(int argc, char** argv)
+{
+   GenParam p;
+   const char* file = 0;
+   for (int i = 1; i < argc; ++i) {
+      bool hasValue = i + 1 < argc;
+      if (strcmp(argv[i], "-ands") == 0 && hasValue) p.ands = strtoull(argv[++i], 0, 10);
+      else if (strcmp(argv[i], "-pis") == 0 && hasValue) p.pis = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-pos") == 0 && hasValue) p.pos = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-depth") == 0 && hasValue) p.depth = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-skew") == 0 && hasValue) p.skew = atof(argv[++i]);
+      else if (strcmp(argv[i], "-redundancy") == 0 && hasValue) p.redundancy = atof(argv[++i]);
+      else if (strcmp(argv[i], "-xor") == 0 && hasValue) p.xorRatio = atof(argv[++i]);
+      else if (strcmp(argv[i], "-mult") == 0 && hasValue) p.multRatio = atof(argv[++i]);
+      else if (strcmp(argv[i], "-width") == 0 && hasValue) p.width = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-seed") == 0 && hasValue) p.seed = atoi(argv[++i]);
+      else if (strcmp(argv[i], "-binary") == 0) p.binary = true;
+      else if (strcmp(argv[i], "-o") == 0 && hasValue) file = argv[++i];
+      else { usage(); return 1; }
+   }
+   if (p.pis == 0 || p.pos == 0 || p.depth == 0 || p.width < 2 || p.skew < 1
+       || p.redundancy < 0 || p.xorRatio < 0 || p.multRatio < 0
+       || p.redundancy + p.xorRatio + p.multRatio > 1 || p.ands > (unsigned long long)INT_MAX / 2) {
+      usage();
+      return 1;
+   }
+
+   // first run: count the ANDs and pick the POs
+   AigGen counter(p, 0);
+   counter.run();
+   vector<unsigned long long> outs;
+   counter.pickOutputs(outs);
+   unsigned long long ands = counter.made();
+
+   FILE* out = file ? fopen(file, "wb") : stdout;
+   if (!out) { cerr << "Error: cannot open \"" << file << "\"!!" << endl; return 1; }
+   fprintf(out, "%s %llu %u 0 %u %llu\n", p.binary ? "aig" : "aag", p.pis + ands, p.pis, (unsigned)outs.size(), ands);
+   if (!p.binary)
+      for (unsigned i = 1; i <= p.pis; ++i) fprintf(out, "%u\n", 2 * i);
+   for (size_t i = 0; i < outs.size(); ++i) fprintf(out, "%llu\n", outs[i]);
+   AigGen writer(p, out);
+   writer.run();
+   fprintf(out, "c\nsynthetic AIG by aigGen\n");
+   if (file) fclose(out);
+   cerr << p.pis << " PIs, " << outs.size() << " POs, " << ands << " ANDs" << endl;
+   return 0;
+}
@@ -0,0 +1,7 @@
+bench.o: bench.cpp ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h ../cir/cirMgr.h ../cir/cirDef.h \
+ ../../include/myHash.h ../cir/cirGate.h ../../include/sat.h \
+ ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h
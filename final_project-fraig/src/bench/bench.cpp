@@ -0,0 +1,234 @@
+/****************************************************************************
+  FileName     [ bench.cpp ]
+  PackageName  [ bench ]
+  Synopsis     [ Benchmark driver of the cir and sat packages ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include "util.h"
+#include "cirMgr.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------
+//    Benchmark phases
+//----------------------------------------------------------------------
+// Every circuit runs in a child process, so the peak RSS is its own.
+// The result hash of a phase is the FNV-1a hash of the circuit written as
+// an AAG, or of the FEC groups after simulation; the same seed gives the
+// same hashes, so a changed hash means a changed result.
+
+static const double BENCH_MIN_MS = 20.0;  // shorter phases are noise, not compared
+
+static size_t
+fnv_hash(const string& str)
+{
+   size_t h = 0xcbf29ce484222325ULL;
+   for (size_t i = 0, n = str.size(); i < n; ++i)
+      h = (h ^ (unsigned char)str[i]) * 0x100000001b3ULL;
+   return h;
+}
+
+static size_t
+aag_hash(const CirMgr& mgr)
+{
+   ostringstream os;
+   mgr.writeAag(os);
+   return fnv_hash(os.str());
+}
+
+static size_t
+fec_hash(const CirMgr& mgr)
+{
+   ostringstream os;
+   streambuf* ori = cout.rdbuf(os.rdbuf());
+   mgr.printFECPairs();
+   cout.rdbuf(ori);
+   return fnv_hash(os.str());
+}
+
+// one "circuit,phase,wall_ms,peak_rss_mb,hash" line per phase
+static bool
+run_circuit(const string& file, unsigned seed, ostream& csv)
+{
+   rnGen.seed(seed);
+   cirMgr = new CirMgr;
+   cirMgr->setVerbose(false);
+   const char* phases[] = { "read", "strash", "optimize", "sim", "fraig" };
+   for (size_t i = 0; i < sizeof(phases) / sizeof(phases[0]); ++i) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      bool ok = true;
+      switch (i) {
+         case 0: ok = cirMgr->readCircuit(file); break;
+         case 1: cirMgr->strash(); break;
+         case 2: cirMgr->optimize(); break;
+         case 3: cirMgr->randomSim(); break;
+         case 4: cirMgr->fraig(); break;
+      }
+      double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      if (!ok) {
+         cerr << "Error: cannot read circuit \"" << file << "\"!!" << endl;
+         return false;
+      }
+      csv << file << ',' << phases[i] << ',' << fixed << setprecision(3) << ms << ','
+          << setprecision(1) << myUsage.getPeakMem() << ',' << hex
+          << (i == 3 ? fec_hash(*cirMgr) : aag_hash(*cirMgr)) << dec << endl;
+   }
+   delete cirMgr; cirMgr = 0;
+   return true;
+}
+
+//----------------------------------------------------------------------
+//    Comparison with a baseline CSV
+//----------------------------------------------------------------------
+struct BenchRow
+{
+   double wallMs;
+   double peakMb;
+   string hash;
+};
+typedef map<pair<string, string>, BenchRow> BenchTable;
+
+static bool
+read_csv(const string& file, BenchTable& table)
+{
+   ifstream ifs(file.c_str());
+   if (!ifs) return false;
+   string line;
+   getline(ifs, line);  // header
+   while (getline(ifs, line)) {
+      vector<string> fields;
+      string tok;
+      for (size_t pos = 0; pos != string::npos; ) {
+         pos = myStrGetTok(line, tok, pos, ',');
+         if (pos != string::npos || !tok.empty()) fields.push_back(tok);
+      }
+      if (fields.size() != 5) continue;
+      BenchRow& row = table[make_pair(fields[0], fields[1])];
+      row.wallMs = atof(fields[2].c_str());
+      row.peakMb = atof(fields[3].c_str());
+      row.hash = fields[4];
+   }
+   return true;
+}
+
+// return the number of regressions: wall time or peak RSS more than
+// "threshold" percent over the baseline
+static size_t
+compare_csv(const BenchTable& baseline, const BenchTable& current, double threshold)
+{
+   size_t compared = 0, regressions = 0, changed = 0;
+   cout << fixed << setprecision(1);
+   for (BenchTable::const_iterator it = current.begin(); it != current.end(); ++it) {
+      BenchTable::const_iterator base = baseline.find(it->first);
+      if (base == baseline.end()) continue;
+      ++compared;
+      const BenchRow& b = base->second, & c = it->second;
+      const string name = it->first.first + " " + it->first.second;
+      if (b.wallMs >= BENCH_MIN_MS && c.wallMs > b.wallMs * (1 + threshold / 100)) {
+         cout << "REGRESSION  " << name << " wall " << b.wallMs << " -> " << c.wallMs
+              << " ms (+" << (c.wallMs / b.wallMs - 1) * 100 << "%)" << endl;
+         ++regressions;
+      }
+      if (c.peakMb > b.peakMb * (1 + threshold / 100)) {
+         cout << "REGRESSION  " << name << " peak RSS " << b.peakMb << " -> " << c.peakMb
+              << " MB (+" << (c.peakMb / b.peakMb - 1) * 100 << "%)" << endl;
+         ++regressions;
+      }
+      if (b.hash != c.hash) {
+         cout << "CHANGED     " << name << " hash " << b.hash << " -> " << c.hash << endl;
+         ++changed;
+      }
+   }
+   cout << compared << " phase(s) compared, " << regressions << " regression(s) over "
+        << threshold << "%, " << changed << " changed result(s)" << endl;
+   return regressions;
+}
+
+//----------------------------------------------------------------------
+//    main()
+//----------------------------------------------------------------------
+static void
+usage()
+{
+   cout << "Usage: fraigBench [-Output <csvFile>] [-Compare <baselineCsv>] "
+        << "[-Threshold <percent>] [-Seed <int>] <aagFile>..." << endl;
+}
+
+static void
+myexit()
+{
+   usage();
+   exit(-1);
+}
+
+int
+main(int argc, char** argv)
+{
+   string output = "bench.csv", baseline;
+   int threshold = 20, seed = 0;
+   vector<string> files;
+   for (int i = 1; i < argc; ++i) {
+      string* str = 0;
+      int* value = 0;
+      if (myStrNCmp("-Output", argv[i], 2) == 0) str = &output;
+      else if (myStrNCmp("-Compare", argv[i], 2) == 0) str = &baseline;
+      else if (myStrNCmp("-Threshold", argv[i], 2) == 0) value = &threshold;
+      else if (myStrNCmp("-Seed", argv[i], 2) == 0) value = &seed;
+      else if (argv[i][0] == '-') {
+         cerr << "Error: unknown argument \"" << argv[i] << "\"!!\n";
+         myexit();
+      }
+      else { files.push_back(argv[i]); continue; }
+      if (++i == argc) {
+         cerr << "Error: missing value after \"" << argv[i-1] << "\"!!\n";
+         myexit();
+      }
+      if (str) *str = argv[i];
+      else if (!myStr2Int(argv[i], *value) || *value < 0) {
+         cerr << "Error: illegal value \"" << argv[i] << "\"!!\n";
+         myexit();
+      }
+   }
+   if (files.empty()) myexit();
+
+   BenchTable base;
+   if (!baseline.empty() && !read_csv(baseline, base)) {
+      cerr << "Error: cannot open file \"" << baseline << "\"!!\n";
+      return 1;
+   }
+   {
+      ofstream csv(output.c_str());
+      if (!csv) {
+         cerr << "Error: cannot open file \"" << output << "\"!!\n";
+         return 1;
+      }
+      csv << "circuit,phase,wall_ms,peak_rss_mb,hash" << endl;
+   }
+   for (size_t i = 0; i < files.size(); ++i) {
+      cout << "Running " << files[i] << "..." << endl;
+      pid_t pid = fork();
+      if (pid == 0) {
+         ofstream csv(output.c_str(), ios::app);
+         _exit(run_circuit(files[i], seed, csv) ? 0 : 1);
+      }
+      int status = 0;
+      if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status))
+         cerr << "Error: benchmark of \"" << files[i] << "\" crashed!!" << endl;
+   }
+   cout << "Results written to " << output << endl;
+
+   if (baseline.empty()) return 0;
+   BenchTable current;
+   read_csv(output, current);
+   return compare_csv(base, current, threshold) ? 1 : 0;
+}
@@ -1,32 +1,85 @@
-cirGate.o: cirGate.cpp cirGate.h cirDef.h ../../include/myHash.h \
- ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
- ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h cirMgr.h ../../include/util.h \
+cirBalance.o: cirBalance.cpp cirMgr.h cirDef.h ../../include/myHash.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
  ../../include/rnGen.h ../../include/myUsage.h
-cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
+cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
  ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
  ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h ../../include/util.h \
- ../../include/rnGen.h ../../include/myUsage.h
-cirSim.o: cirSim.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h cirCmd.h \
+ ../../include/cmdParser.h ../../include/cmdCharDef.h cirCut.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirCut.o: cirCut.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
  ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
  ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h ../../include/util.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h cirCut.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirEquiv.o: cirEquiv.cpp cirMgr.h cirDef.h ../../include/myHash.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
  ../../include/rnGen.h ../../include/myUsage.h
 cirFraig.o: cirFraig.cpp cirMgr.h cirDef.h ../../include/myHash.h \
  cirGate.h ../../include/sat.h ../../include/Solver.h \
  ../../include/SolverTypes.h ../../include/Global.h \
  ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
- ../../include/File.h ../../include/util.h ../../include/rnGen.h \
- ../../include/myUsage.h
-cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirGate.o: cirGate.cpp cirGate.h cirDef.h ../../include/myHash.h \
+ ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h cirMgr.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirMap.o: cirMap.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
  ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
  ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h cirCmd.h \
- ../../include/cmdParser.h ../../include/cmdCharDef.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h cirCut.h \
  ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
+ ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
 cirOpt.o: cirOpt.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
  ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
  ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
- ../../include/Proof.h ../../include/File.h ../../include/util.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirResub.o: cirResub.cpp cirMgr.h cirDef.h ../../include/myHash.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirRewrite.o: cirRewrite.cpp cirMgr.h cirDef.h ../../include/myHash.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h cirCut.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirSEquiv.o: cirSEquiv.cpp cirMgr.h cirDef.h ../../include/myHash.h \
+ cirGate.h ../../include/sat.h ../../include/Solver.h \
+ ../../include/SolverTypes.h ../../include/Global.h \
+ ../../include/VarOrder.h ../../include/Heap.h ../../include/Proof.h \
+ ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirSim.o: cirSim.cpp cirMgr.h cirDef.h ../../include/myHash.h cirGate.h \
+ ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h \
+ ../../include/Global.h ../../include/VarOrder.h ../../include/Heap.h \
+ ../../include/Proof.h ../../include/File.h ../../include/Portfolio.h \
+ ../../include/Simplifier.h ../../include/myStats.h ../../include/util.h \
  ../../include/rnGen.h ../../include/myUsage.h
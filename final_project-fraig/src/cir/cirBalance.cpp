@@ -0,0 +1,148 @@
+/****************************************************************************
+  FileName     [ cirBalance.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir AND-tree balancing functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <queue>
+#include <climits>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+
+/***********************************************/
+/*   Public member functions about balancing   */
+/***********************************************/
+// A supergate is a multi-input AND: its root, and the AIG gates below it reached by non-inverted
+// edges which have no other fanout. Supergate roots are rebuilt in dfs order, so their leaves are
+// balanced before them; the leaves are paired up from the lowest levels, which gives the
+// minimum depth for the levels of the leaves. Existing gates are reused through a strash table.
+void
+CirMgr::balance()
+{
+    STAT_TIMER("balance");
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    vector<unsigned int> level_list;
+    get_level_list(dfs_list, level_list);
+    auto get_depth = [&]() // the highest level of the POs
+    {
+        unsigned int depth = 0;
+        for(auto& e:_po_list)
+            depth = std::max(depth, level_list[_gate_list[e]->get_i_list()[0].get_gate_p()->get_variable_id()]);
+        return depth;
+    };
+    unsigned int ori_depth = get_depth();
+    size_t ori_aig_num = _header_A, rebuilt_num = 0;
+
+    HashMap<StrashKey, unsigned int> strash_map(getHashSize(dfs_list.size()));
+    for(auto& e:dfs_list)
+        if(_gate_list[e]->get_type() == AIG_GATE)
+            strash_map.insert(StrashKey(_gate_list[e]), e);
+    auto is_inside = [&](unsigned int lit) // an input of the supergate, not a leaf
+    {
+        const CirGate* gate = _gate_list[lit / 2];
+        return !(lit & 0x1) && gate->get_type() == AIG_GATE && gate->get_o_list().size() == 1;
+    };
+
+    IdList leaves, stack;
+    typedef pair<unsigned int, unsigned int> LevelLit;
+    priority_queue<LevelLit, vector<LevelLit>, greater<LevelLit> > queue;
+    for(auto& e:dfs_list)
+    {
+        const CirGate* gate = _gate_list[e];
+        if(gate->get_type() != AIG_GATE)
+            continue;
+        // the inputs may be rebuilt gates
+        level_list[e] = 0;
+        for(auto& input:gate->get_i_list())
+            level_list[e] = std::max(level_list[e], level_list[input.get_gate_p()->get_variable_id()] + 1);
+        if(gate->get_o_list().size() == 1 && !gate->get_o_list()[0].is_inverted()
+           && gate->get_o_list()[0].get_gate_p()->get_type() == AIG_GATE)
+            continue;
+
+        leaves.clear();
+        stack.clear();
+        for(auto& input:gate->get_i_list())
+            stack.push_back(input.get_gate_p()->get_variable_id() * 2 + (input.is_inverted() ? 1 : 0));
+        while(!stack.empty())
+        {
+            unsigned int lit = stack.back();
+            stack.pop_back();
+            if(!is_inside(lit))
+            {
+                leaves.push_back(lit);
+                continue;
+            }
+            for(auto& input:_gate_list[lit / 2]->get_i_list())
+                stack.push_back(input.get_gate_p()->get_variable_id() * 2 + (input.is_inverted() ? 1 : 0));
+        }
+        if(leaves.size() <= 2)
+            continue;
+
+        // x & x = x, x & !x = 0, x & 1 = x
+        sort(leaves.begin(), leaves.end());
+        leaves.erase(unique(leaves.begin(), leaves.end()), leaves.end());
+        bool is_zero = leaves[0] == 0;
+        for(size_t i = 1;i < leaves.size() && !is_zero;++i)
+            is_zero = (leaves[i] ^ leaves[i - 1]) == 1;
+        if(leaves[0] == 1)
+            leaves.erase(leaves.begin());
+
+        unsigned int root_lit = is_zero ? 0 : 1;
+        if(!is_zero && !leaves.empty())
+        {
+            for(auto& lit:leaves)
+                queue.push(make_pair(level_list[lit / 2], lit));
+            while(queue.size() > 1)
+            {
+                LevelLit a = queue.top();
+                queue.pop();
+                LevelLit b = queue.top();
+                queue.pop();
+                unsigned int lit = find_aig_gate(strash_map, a.second, b.second);
+                if(lit == UINT_MAX || lit / 2 == e)
+                {
+                    unsigned int gid = add_aig_gate(a.second, b.second);
+                    strash_map.update(StrashKey(a.second, b.second), gid);
+                    level_list.push_back(std::max(a.first, b.first) + 1);
+                    lit = gid * 2;
+                }
+                queue.push(make_pair(level_list[lit / 2], lit));
+            }
+            root_lit = queue.top().second;
+            queue.pop();
+        }
+        if(root_lit / 2 == e)
+            continue;
+
+        IdList inputs;
+        for(auto& input:gate->get_i_list())
+            inputs.push_back(input.get_gate_p()->get_variable_id());
+        merge_gate(e, CirGate::RelatedGate(_gate_list[root_lit / 2], root_lit & 0x1));
+        for(auto& g:inputs)
+            remove_dangling(g);
+        ++rebuilt_num;
+    }
+
+    dfs_list.clear();
+    get_dfs_list(dfs_list);
+    get_level_list(dfs_list, level_list);
+    if(_verbose)
+        cout << "Balancing: " << rebuilt_num << " supergate(s) rebuilt, AIG " << ori_aig_num << " -> " << _header_A
+             << ", depth " << ori_depth << " -> " << get_depth() << endl;
+}
@@ -12,6 +12,7 @@
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "cirCmd.h"
+#include "cirCut.h"
 #include "util.h"
 
 using namespace std;
@@ -30,7 +31,15 @@ initCirCmd()
          cmdMgr->regCmd("CIRSTRash", 6, new CirStrashCmd) &&
          cmdMgr->regCmd("CIRSIMulate", 6, new CirSimCmd) &&
          cmdMgr->regCmd("CIRFraig", 4, new CirFraigCmd) &&
-         cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd)
+         cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd) &&
+         cmdMgr->regCmd("CIREQuiv", 4, new CirEquivCmd) &&
+         cmdMgr->regCmd("CIRCut", 4, new CirCutCmd) &&
+         cmdMgr->regCmd("CIRMap", 4, new CirMapCmd) &&
+         cmdMgr->regCmd("CIRREWrite", 6, new CirRewriteCmd) &&
+         cmdMgr->regCmd("CIRBalance", 4, new CirBalanceCmd) &&
+         cmdMgr->regCmd("CIRRESub", 6, new CirResubCmd) &&
+         cmdMgr->regCmd("CIRSEquiv", 5, new CirSEquivCmd) &&
+         cmdMgr->regCmd("CIRSTAT", 6, new CirStatCmd)
       )) {
       cerr << "Registering \"cir\" commands fails... exiting" << endl;
       return false;
@@ -390,7 +399,8 @@ CirSimCmd::exec(const string& option)
 
    ifstream patternFile;
    ofstream logFile;
-   bool doRandom = false, doFile = false, doLog = false;
+   bool doRandom = false, doFile = false, doLog = false, doCycles = false;
+   int cycles = 0;
    for (size_t i = 0, n = options.size(); i < n; ++i) {
       if (myStrNCmp("-Random", options[i], 2) == 0) {
          if (doRandom || doFile)
@@ -407,6 +417,15 @@ CirSimCmd::exec(const string& option)
             return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
          doFile = true;
       }
+      else if (myStrNCmp("-Cycles", options[i], 2) == 0) {
+         if (doCycles)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], cycles) || cycles < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         doCycles = true;
+      }
       else if (myStrNCmp("-Output", options[i], 2) == 0) {
          if (doLog)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
@@ -423,13 +442,19 @@ CirSimCmd::exec(const string& option)
 
    if (!doRandom && !doFile)
       return CmdExec::errorOption(CMD_OPT_MISSING, "");
+   if (doCycles && doFile) {
+      cerr << "Error: -Cycles is only for random simulation!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
 
    assert (curCmd != CIRINIT);
    if (doLog)
       cirMgr->setSimLog(&logFile);
    else cirMgr->setSimLog(0);
 
-   if (doRandom)
+   if (doCycles)
+      cirMgr->seqSim(cycles);
+   else if (doRandom)
       cirMgr->randomSim();
    else
       cirMgr->fileSim(patternFile);
@@ -442,7 +467,7 @@ CirSimCmd::exec(const string& option)
 void
 CirSimCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRSIMulate <-Random | -File <string patternFile>>\n"
+   os << "Usage: CIRSIMulate <-Random [-Cycles (int num)] | -File <string patternFile>>\n"
       << "                   [-Output (string logFile)]" << endl;
 }
 
@@ -454,7 +479,9 @@ CirSimCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRFraig
+//    CIRFraig [-Conflict (int budget)] [-Propagation (int budget)]
+//             [-Retry (int budget)] [-Threads (int num)] [-POrtfolio (int num)]
+//             [-Dump (string prefix)]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirFraigCmd::exec(const string& option)
@@ -467,13 +494,58 @@ CirFraigCmd::exec(const string& option)
    vector<string> options;
    CmdExec::lexOptions(option, options);
 
-   if (!options.empty())
-      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+   // no limit on conflicts and propagations, no retry, single thread by default
+   int conflicts = -1, propagations = -1, retry = 0, threads = 1, portfolio = 1;
+   bool doConflict = false, doPropagation = false, doRetry = false, doThreads = false;
+   bool doPortfolio = false;
+   bool doDump = false;
+   string dumpPrefix;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* value = 0;
+      if (myStrNCmp("-Dump", options[i], 2) == 0) {
+         if (doDump) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doDump = true;
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         dumpPrefix = options[i];
+         continue;
+      }
+      else if (myStrNCmp("-Conflict", options[i], 2) == 0) {
+         if (doConflict) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doConflict = true; value = &conflicts;
+      }
+      else if (myStrNCmp("-Propagation", options[i], 2) == 0) {
+         if (doPropagation) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doPropagation = true; value = &propagations;
+      }
+      else if (myStrNCmp("-Retry", options[i], 2) == 0) {
+         if (doRetry) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doRetry = true; value = &retry;
+      }
+      else if (myStrNCmp("-Threads", options[i], 2) == 0) {
+         if (doThreads) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doThreads = true; value = &threads;
+      }
+      else if (myStrNCmp("-Portfolio", options[i], 3) == 0) {
+         if (doPortfolio) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doPortfolio = true; value = &portfolio;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *value) || *value < (value == &threads || value == &portfolio ? 1 : 0))
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
 
    if (curCmd != CIRSIMULATE) {
       cerr << "Error: circuit is not yet simulated!!" << endl;
       return CMD_EXEC_ERROR;
    }
+   cirMgr->setFraigBudget(conflicts, propagations, retry);
+   cirMgr->setFraigThreads(threads);
+   cirMgr->setFraigPortfolio(portfolio);
+   cirMgr->setFraigDump(dumpPrefix);
    cirMgr->fraig();
    curCmd = CIRFRAIG;
 
@@ -483,7 +555,10 @@ CirFraigCmd::exec(const string& option)
 void
 CirFraigCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRFraig" << endl;
+   os << "Usage: CIRFraig [-Conflict (int budget)] [-Propagation (int budget)]\n"
+      << "                [-Retry (int budget)] [-Threads (int num)]\n"
+      << "                [-POrtfolio (int num)]\n"
+      << "                [-Dump (string prefix)]" << endl;
 }
 
 void
@@ -565,3 +640,434 @@ CirWriteCmd::help() const
         << "write the netlist to an ASCII AIG file (.aag)\n";
 }
 
+//----------------------------------------------------------------------
+//    CIREQuiv <(string goldenFile)> <(string revisedFile)>
+//             [-Conflict (int budget)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirEquivCmd::exec(const string& option)
+{
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   int conflicts = -1;
+   bool doConflict = false;
+   vector<string> fileNames;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Conflict", options[i], 2) == 0) {
+         if (doConflict) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doConflict = true;
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], conflicts) || conflicts < 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      else {
+         if (fileNames.size() == 2)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         fileNames.push_back(options[i]);
+      }
+   }
+   if (fileNames.size() < 2)
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   // the miter has its own manager, the current circuit is not touched
+   CirMgr miter;
+   if (!miter.readMiter(fileNames[0], fileNames[1]))
+      return CMD_EXEC_ERROR;
+   miter.setVerbose(false);
+   miter.setFraigBudget(conflicts, -1, 0);
+   miter.proveMiter();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirEquivCmd::usage(ostream& os) const
+{
+   os << "Usage: CIREQuiv <(string goldenFile)> <(string revisedFile)>\n"
+      << "                [-Conflict (int budget)]" << endl;
+}
+
+void
+CirEquivCmd::help() const
+{
+   cout << setw(15) << left << "CIREQuiv: "
+        << "check the combinational equivalence of two circuits\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRCut [(int gateId)] [-K (int k)] [-Limit (int num)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirCutCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   // 4-input cuts, 8 per gate by default
+   int k = 4, limit = 8, gateId = -1;
+   bool doK = false, doLimit = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* value = 0;
+      if (myStrNCmp("-K", options[i], 2) == 0) {
+         if (doK) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doK = true; value = &k;
+      }
+      else if (myStrNCmp("-Limit", options[i], 2) == 0) {
+         if (doLimit) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doLimit = true; value = &limit;
+      }
+      else if (gateId < 0) {
+         if (!myStr2Int(options[i], gateId) || gateId < 0)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         if (!cirMgr->getGate(gateId)) {
+            cerr << "Error: Gate(" << gateId << ") not found!!" << endl;
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         }
+         continue;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *value) || *value < 1 || (value == &k && *value > (int)CirCut::MAX_SIZE))
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   cirMgr->printCuts(k, limit, gateId);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirCutCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRCut [(int gateId)] [-K (int k)] [-Limit (int num)]" << endl;
+}
+
+void
+CirCutCmd::help() const
+{
+   cout << setw(15) << left << "CIRCut: "
+        << "enumerate the k-feasible priority cuts of the gates\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRMap [-K (int k)] [-Limit (int num)] [-Output (string blifFile)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirMapCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   // 6-input LUTs, 8 cuts per gate by default
+   int k = 6, limit = 8;
+   bool doK = false, doLimit = false, hasFile = false;
+   ofstream outfile;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* value = 0;
+      if (myStrNCmp("-K", options[i], 2) == 0) {
+         if (doK) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doK = true; value = &k;
+      }
+      else if (myStrNCmp("-Limit", options[i], 2) == 0) {
+         if (doLimit) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doLimit = true; value = &limit;
+      }
+      else if (myStrNCmp("-Output", options[i], 2) == 0) {
+         if (hasFile) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         outfile.open(options[i].c_str(), ios::out);
+         if (!outfile)
+            return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         hasFile = true;
+         continue;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *value) || *value < 1 || (value == &k && (*value < 2 || *value > (int)CirCut::MAX_SIZE)))
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   cirMgr->mapLut(k, limit, hasFile ? &outfile : 0);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirMapCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRMap [-K (int k)] [-Limit (int num)] [-Output (string blifFile)]" << endl;
+}
+
+void
+CirMapCmd::help() const
+{
+   cout << setw(15) << left << "CIRMap: "
+        << "map the circuit into k-input LUTs\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRREWrite
+//----------------------------------------------------------------------
+CmdExecStatus
+CirRewriteCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   assert(curCmd != CIRINIT);
+   if (curCmd == CIRSIMULATE) {
+      cerr << "Error: circuit has been simulated!! Do \"CIRFraig\" first!!"
+           << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->rewrite();
+   curCmd = CIROPT;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirRewriteCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRREWrite" << endl;
+}
+
+void
+CirRewriteCmd::help() const
+{
+   cout << setw(15) << left << "CIRREWrite: "
+        << "rewrite 4-input cuts with optimal NPN structures\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRBalance
+//----------------------------------------------------------------------
+CmdExecStatus
+CirBalanceCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   assert(curCmd != CIRINIT);
+   if (curCmd == CIRSIMULATE) {
+      cerr << "Error: circuit has been simulated!! Do \"CIRFraig\" first!!"
+           << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->balance();
+   curCmd = CIROPT;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirBalanceCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRBalance" << endl;
+}
+
+void
+CirBalanceCmd::help() const
+{
+   cout << setw(15) << left << "CIRBalance: "
+        << "reduce the depth by balancing the AND trees\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRRESub
+//----------------------------------------------------------------------
+CmdExecStatus
+CirResubCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   assert(curCmd != CIRINIT);
+   if (curCmd == CIRSIMULATE) {
+      cerr << "Error: circuit has been simulated!! Do \"CIRFraig\" first!!"
+           << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->resub();
+   curCmd = CIROPT;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirResubCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRRESub" << endl;
+}
+
+void
+CirResubCmd::help() const
+{
+   cout << setw(15) << left << "CIRRESub: "
+        << "resubstitute gates with divisors found by simulation\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRSEquiv [-K (int depth)] [-Cycles (int num)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirSEquivCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   // 1-step induction on the candidates of 32-cycle traces by default
+   int k = 1, cycles = 32;
+   bool doK = false, doCycles = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* value = 0;
+      if (myStrNCmp("-K", options[i], 2) == 0) {
+         if (doK) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doK = true; value = &k;
+      }
+      else if (myStrNCmp("-Cycles", options[i], 2) == 0) {
+         if (doCycles) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doCycles = true; value = &cycles;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *value) || *value < 1)
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   assert(curCmd != CIRINIT);
+   if (curCmd == CIRSIMULATE) {
+      cerr << "Error: circuit has been simulated!! Do \"CIRFraig\" first!!"
+           << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->sequivalence(k, cycles);
+   curCmd = CIROPT;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirSEquivCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSEquiv [-K (int depth)] [-Cycles (int num)]" << endl;
+}
+
+void
+CirSEquivCmd::help() const
+{
+   cout << setw(15) << left << "CIRSEquiv: "
+        << "merge sequentially equivalent latches and gates\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRSTAT [-Sat | -Counters | -Json [(string jsonFile)] | -Reset]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirStatCmd::exec(const string& option)
+{
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   if (options.size() > 2)
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[2]);
+   if (options.size() == 2 && myStrNCmp("-Json", options[0], 2) != 0)
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[1]);
+
+   if (options.empty() || myStrNCmp("-Sat", options[0], 2) == 0) {
+      if (!cirMgr) {
+         cerr << "Error: circuit is not yet constructed!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      cirMgr->printSatStats();
+      return CMD_EXEC_DONE;
+   }
+   if (myStrNCmp("-Counters", options[0], 2) != 0 && myStrNCmp("-Json", options[0], 2) != 0 &&
+       myStrNCmp("-Reset", options[0], 2) != 0)
+      return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[0]);
+#ifdef MY_STATS
+   if (myStrNCmp("-Reset", options[0], 2) == 0)
+      myStats.reset();
+   else if (myStrNCmp("-Counters", options[0], 2) == 0)
+      myStats.report(cout);
+   else if (options.size() == 1)
+      myStats.reportJson(cout);
+   else {
+      ofstream jsonFile(options[1].c_str());
+      if (!jsonFile)
+         return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[1]);
+      myStats.reportJson(jsonFile);
+   }
+#else
+   cerr << "Error: the counters are not compiled in (build with -DMY_STATS)!!" << endl;
+   return CMD_EXEC_ERROR;
+#endif
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirStatCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSTAT [-Sat | -Counters | -Json [(string jsonFile)] | -Reset]" << endl;
+}
+
+void
+CirStatCmd::help() const
+{
+   cout << setw(15) << left << "CIRSTAT: "
+        << "print statistics of the last operations\n";
+}
@@ -20,5 +20,13 @@ CmdClass(CirStrashCmd);
 CmdClass(CirSimCmd);
 CmdClass(CirFraigCmd);
 CmdClass(CirWriteCmd);
+CmdClass(CirEquivCmd);
+CmdClass(CirCutCmd);
+CmdClass(CirMapCmd);
+CmdClass(CirRewriteCmd);
+CmdClass(CirBalanceCmd);
+CmdClass(CirResubCmd);
+CmdClass(CirSEquivCmd);
+CmdClass(CirStatCmd);
 
 #endif // CIR_CMD_H
@@ -0,0 +1,366 @@
+/****************************************************************************
+  FileName     [ cirCut.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define k-feasible cut enumeration with truth tables ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirCut.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const uint64_t VAR_TRUTH[CirCut::MAX_SIZE] =
+{
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL
+};
+
+/*****************************/
+/*   class CirCut functions   */
+/*****************************/
+uint64_t
+CirCut::var_truth(unsigned int i)
+{
+    assert(i < MAX_SIZE);
+    return VAR_TRUTH[i];
+}
+
+// the cofactors of variable i differ
+bool
+CirCut::depends_on(uint64_t truth, unsigned int i)
+{
+    return ((truth >> (1 << i)) & ~VAR_TRUTH[i]) != (truth & ~VAR_TRUTH[i]);
+}
+
+// exchange variables i and j: the patterns with (i, j) = (1, 0) and (0, 1) trade their bits
+uint64_t
+CirCut::swap_vars(uint64_t truth, unsigned int i, unsigned int j)
+{
+    if(i == j)
+        return truth;
+    if(i > j)
+        swap(i, j);
+    unsigned int shift = (1 << j) - (1 << i);
+    uint64_t mask = VAR_TRUTH[i] & ~VAR_TRUTH[j];
+    return (truth & ~(mask | (mask << shift))) | ((truth & mask) << shift) | ((truth >> shift) & mask);
+}
+
+bool
+CirCut::dominates(const CirCut& c) const
+{
+    if(_size > c._size || (_sign & ~c._sign))
+        return false;
+    unsigned int j = 0;
+    for(unsigned int i = 0;i < _size;++i)
+    {
+        while(j < c._size && c._leaves[j] < _leaves[i])
+            ++j;
+        if(j == c._size || c._leaves[j] != _leaves[i])
+            return false;
+    }
+    return true;
+}
+
+void
+CirCut::set_sign()
+{
+    _sign = 0;
+    for(unsigned int i = 0;i < _size;++i)
+        _sign |= (uint64_t)1 << (_leaves[i] % 64);
+}
+
+/********************************/
+/*   class CirCutMgr functions   */
+/********************************/
+// A gate is processed once and its cuts are merged from at most (cut_limit + 1)^2 pairs,
+// so the run time is linear in the number of gates
+void
+CirCutMgr::enumerate(const GateList& gate_list, const IdList& dfs_list, const vector<unsigned int>& level_list)
+{
+    assert(_k >= 1 && _k <= CirCut::MAX_SIZE);
+    _pool.clear();
+    _pool.reserve(dfs_list.size() * 4);
+    _cut_begin.assign(gate_list.size(), 0);
+    _cut_num.assign(gate_list.size(), 0);
+    if(_priority == CUT_PRIORITY_DEPTH)
+    {
+        _depth.assign(gate_list.size(), 0);
+        _flow.assign(gate_list.size(), 0);
+    }
+
+    // fewer leaves first, then the lower ones (a larger cone)
+    auto max_level = [&](const CirCut& c)
+    {
+        unsigned int level = 0;
+        for(unsigned int i = 0;i < c._size;++i)
+            if(level_list[c._leaves[i]] > level)
+                level = level_list[c._leaves[i]];
+        return level;
+    };
+    auto cut_depth = [&](const CirCut& c)
+    {
+        unsigned int depth = 0;
+        for(unsigned int i = 0;i < c._size;++i)
+            if(_depth[c._leaves[i]] > depth)
+                depth = _depth[c._leaves[i]];
+        return depth + 1;
+    };
+    auto cut_flow = [&](const CirCut& c)
+    {
+        float flow = 1;
+        for(unsigned int i = 0;i < c._size;++i)
+            flow += _flow[c._leaves[i]];
+        return flow;
+    };
+    auto higher_priority = [&](const CirCut& a, const CirCut& b)
+    {
+        if(_priority == CUT_PRIORITY_DEPTH)
+        {
+            unsigned int depth_a = cut_depth(a), depth_b = cut_depth(b);
+            if(depth_a != depth_b)
+                return depth_a < depth_b;
+            float flow_a = cut_flow(a), flow_b = cut_flow(b);
+            if(flow_a != flow_b)
+                return flow_a < flow_b;
+            return a._size < b._size;
+        }
+        if(a._size != b._size)
+            return a._size < b._size;
+        return max_level(a) < max_level(b);
+    };
+
+    vector<CirCut> candidates;
+    for(auto& e:dfs_list)
+    {
+        const CirGate* gate = gate_list[e];
+        if(gate->get_type() == CONST_GATE || gate->get_type() == PI_GATE || gate->get_type() == LATCH_GATE)
+        {
+            add_trivial_cut(e, gate->get_type() == CONST_GATE);
+            continue;
+        }
+        if(gate->get_type() != AIG_GATE)
+            continue;
+
+        const CirGate::RelatedGate& ia = gate->get_i_list()[0];
+        const CirGate::RelatedGate& ib = gate->get_i_list()[1];
+        unsigned int a = ia.get_gate_p()->get_variable_id();
+        unsigned int b = ib.get_gate_p()->get_variable_id();
+        for(unsigned int input:{a, b}) // floating inputs are free variables
+            if(_cut_num[input] == 0)
+                add_trivial_cut(input, false);
+
+        candidates.clear();
+        const CirCut* cuts_a = get_cuts(a);
+        const CirCut* cuts_b = get_cuts(b);
+        for(unsigned int i = 0;i < _cut_num[a];++i)
+        {
+            for(unsigned int j = 0;j < _cut_num[b];++j)
+            {
+                CirCut cut;
+                if(!merge_cuts(cuts_a[i], cuts_b[j], cut))
+                    continue;
+                uint64_t truth_a = stretch_truth(cuts_a[i], cut);
+                uint64_t truth_b = stretch_truth(cuts_b[j], cut);
+                cut._truth = (ia.is_inverted() ? ~truth_a : truth_a) & (ib.is_inverted() ? ~truth_b : truth_b);
+                minimize_support(cut);
+
+                bool dominated = false;
+                for(size_t k = 0;k < candidates.size() && !dominated;++k)
+                    dominated = candidates[k].dominates(cut);
+                if(dominated)
+                    continue;
+                for(size_t k = 0;k < candidates.size();)
+                {
+                    if(cut.dominates(candidates[k]))
+                    {
+                        candidates[k] = candidates.back();
+                        candidates.pop_back();
+                    }
+                    else
+                        ++k;
+                }
+                candidates.push_back(cut);
+            }
+        }
+
+        size_t keep_num = candidates.size() < _cut_limit ? candidates.size() : _cut_limit;
+        partial_sort(candidates.begin(), candidates.begin() + keep_num, candidates.end(), higher_priority);
+        add_trivial_cut(e, false);
+        for(size_t i = 0;i < keep_num;++i)
+            _pool.push_back(candidates[i]);
+        _cut_num[e] += keep_num;
+        if(_priority == CUT_PRIORITY_DEPTH && keep_num)
+        {
+            size_t fanout_num = gate->get_o_list().size();
+            _depth[e] = cut_depth(candidates[0]);
+            _flow[e] = cut_flow(candidates[0]) / (fanout_num ? fanout_num : 1);
+        }
+    }
+}
+
+void
+CirCutMgr::add_trivial_cut(unsigned int gid, bool is_const)
+{
+    CirCut cut;
+    cut._size = 0;
+    cut._truth = 0;
+    if(!is_const)
+    {
+        cut._leaves[cut._size++] = gid;
+        cut._truth = CirCut::var_truth(0);
+    }
+    cut.set_sign();
+    _cut_begin[gid] = _pool.size();
+    _cut_num[gid] = 1;
+    _pool.push_back(cut);
+}
+
+// union of the leaves, false if there are more than k
+bool
+CirCutMgr::merge_cuts(const CirCut& a, const CirCut& b, CirCut& cut) const
+{
+    if((unsigned int)__builtin_popcountll(a._sign | b._sign) > _k)
+        return false;
+    unsigned int i = 0, j = 0, n = 0;
+    while(i < a._size || j < b._size)
+    {
+        if(n == _k)
+            return false;
+        if(j == b._size || (i < a._size && a._leaves[i] < b._leaves[j]))
+            cut._leaves[n++] = a._leaves[i++];
+        else if(i == a._size || b._leaves[j] < a._leaves[i])
+            cut._leaves[n++] = b._leaves[j++];
+        else
+        {
+            cut._leaves[n++] = a._leaves[i++];
+            ++j;
+        }
+    }
+    cut._size = n;
+    cut.set_sign();
+    return true;
+}
+
+// the table of "from" over the leaves of "to" (a superset), moving the variables up from the last one;
+// the position a variable moves to is always unused
+uint64_t
+CirCutMgr::stretch_truth(const CirCut& from, const CirCut& to)
+{
+    uint64_t truth = from._truth;
+    unsigned int j = to._size;
+    for(unsigned int i = from._size;i-- > 0;)
+    {
+        while(to._leaves[--j] != from._leaves[i]) ;
+        truth = CirCut::swap_vars(truth, i, j);
+    }
+    return truth;
+}
+
+// remove the leaves the function doesn't depend on, an unused variable is moved to the top
+void
+CirCutMgr::minimize_support(CirCut& cut)
+{
+    for(unsigned int i = 0;i < cut._size;)
+    {
+        if(CirCut::depends_on(cut._truth, i))
+        {
+            ++i;
+            continue;
+        }
+        for(unsigned int v = i + 1;v < cut._size;++v)
+        {
+            cut._truth = CirCut::swap_vars(cut._truth, v - 1, v);
+            cut._leaves[v - 1] = cut._leaves[v];
+        }
+        --cut._size;
+    }
+    cut.set_sign();
+}
+
+/*****************************************/
+/*   Public member functions about cuts   */
+/*****************************************/
+// gid < 0: statistics of all the gates, otherwise the cuts of gate "gid" with their truth tables
+void
+CirMgr::printCuts(unsigned int k, unsigned int cut_limit, int gid) const
+{
+    CirCutMgr cut_mgr(k, cut_limit);
+    get_cuts(cut_mgr);
+
+    if(gid >= 0)
+    {
+        unsigned int cut_num = cut_mgr.get_cut_num(gid);
+        const CirCut* cuts = cut_num ? cut_mgr.get_cuts(gid) : 0;
+        cout << "Cuts of " << _gate_list[gid]->get_type_str() << " " << gid << ":" << endl;
+        for(unsigned int i = 0;i < cut_num;++i)
+        {
+            const CirCut& cut = cuts[i];
+            cout << "[" << i << "] {";
+            for(unsigned int j = 0;j < cut.size();++j)
+                cout << (j ? " " : "") << cut.leaf(j);
+            // only the 2^size bits which matter
+            unsigned int digit_num = cut.size() <= 2 ? 1 : 1 << (cut.size() - 2);
+            uint64_t truth = cut.size() == CirCut::MAX_SIZE ? cut.truth() : cut.truth() & (((uint64_t)1 << (1 << cut.size())) - 1);
+            cout << "} 0x" << hex << setw(digit_num) << setfill('0') << truth << dec << setfill(' ') << endl;
+        }
+        return;
+    }
+
+    size_t aig_num = 0, cut_num = 0;
+    vector<size_t> size_count(k + 1, 0);
+    for(unsigned int i = 0;i < _gate_list.size();++i)
+    {
+        if(_gate_list[i]->get_type() != AIG_GATE || cut_mgr.get_cut_num(i) == 0)
+            continue;
+        ++aig_num;
+        const CirCut* cuts = cut_mgr.get_cuts(i);
+        for(unsigned int j = 1;j < cut_mgr.get_cut_num(i);++j) // without the trivial cut
+        {
+            ++cut_num;
+            ++size_count[cuts[j].size()];
+        }
+    }
+    cout << endl;
+    cout << "Cut Statistics (k = " << k << ", " << cut_limit << " cuts per gate)" << endl;
+    cout << "==================" << endl;
+    cout << "  AIG          " << setw(12) << right << aig_num << endl;
+    cout << "  Cuts         " << setw(12) << right << cut_num << endl;
+    for(unsigned int i = 0;i <= k;++i)
+        if(size_count[i])
+            cout << "    " << i << " leaves   " << setw(12) << right << size_count[i] << endl;
+    cout << "  Cuts per AIG " << setw(12) << right << fixed << setprecision(2)
+         << (aig_num ? (double)cut_num / aig_num : 0.0) << endl;
+    cout.unsetf(ios::fixed);
+}
+
+/******************************************/
+/*   Private member functions about cuts   */
+/******************************************/
+void
+CirMgr::get_cuts(CirCutMgr& cut_mgr) const
+{
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    vector<unsigned int> level_list;
+    get_level_list(dfs_list, level_list);
+    cut_mgr.enumerate(_gate_list, dfs_list, level_list);
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+  FileName     [ cirCut.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define k-feasible cut enumeration with truth tables ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_CUT_H
+#define CIR_CUT_H
+
+#include <vector>
+#include <cstdint>
+#include "cirDef.h"
+
+using namespace std;
+
+// A cut of a gate: a set of gates (leaves) which every path from the PIs to the gate goes through.
+// The function of the gate over the leaves is a 6-input truth table, leaf i is variable i
+// and bit p is the value for the input pattern p. A table of fewer leaves is repeated over the
+// unused variables, so the tables of two cuts can be combined bit-wise once their leaves agree.
+class CirCut
+{
+    friend class CirCutMgr;
+public:
+    static const unsigned int MAX_SIZE = 6;
+
+    unsigned int size() const { return _size; }
+    unsigned int leaf(unsigned int i) const { return _leaves[i]; }
+    uint64_t truth() const { return _truth; }
+    // bit (gid % 64) set for every leaf, for quick subset tests
+    uint64_t sign() const { return _sign; }
+    // the leaves of this cut are a subset of the leaves of "c"
+    bool dominates(const CirCut& c) const;
+
+    // truth table of variable i: bit p is set if bit i of p is set
+    static uint64_t var_truth(unsigned int i);
+    static bool depends_on(uint64_t truth, unsigned int i);
+    static uint64_t swap_vars(uint64_t truth, unsigned int i, unsigned int j);
+
+private:
+    unsigned int _leaves[MAX_SIZE]; // variable ids, increasing
+    unsigned int _size;
+    uint64_t _sign;
+    uint64_t _truth;
+
+    void set_sign();
+};
+
+// How the cuts of a gate are ranked when only "cut_limit" of them are kept
+enum CutPriority
+{
+    CUT_PRIORITY_SIZE,  // fewer leaves, then lower leaves (by level)
+    CUT_PRIORITY_DEPTH  // lower depth in cuts, then less area flow, then fewer leaves
+};
+
+// Priority cuts of every gate, computed in topological order by merging the cuts of the two inputs.
+// Each gate keeps its trivial cut (itself) as cut 0 and at most "cut_limit" other cuts ranked by
+// the CutPriority. Dominated cuts are dropped and the leaves a function doesn't depend on are
+// removed. All cuts live in one pool, gate by gate.
+// With CUT_PRIORITY_DEPTH the depth of a gate is the lowest (1 + the highest depth of the leaves)
+// of its cuts, and its area flow is (1 + the area flows of the leaves) / fanouts of that cut;
+// both are 0 for the PIs.
+class CirCutMgr
+{
+public:
+    CirCutMgr(unsigned int k = 4, unsigned int cut_limit = 8, CutPriority priority = CUT_PRIORITY_SIZE):
+        _k(k), _cut_limit(cut_limit), _priority(priority) {}
+
+    // gates in dfs_list must be in topological order; level_list as CirMgr::get_level_list()
+    void enumerate(const GateList& gate_list, const IdList& dfs_list, const vector<unsigned int>& level_list);
+
+    unsigned int get_k() const { return _k; }
+    unsigned int get_cut_limit() const { return _cut_limit; }
+    // 0 for the gates not enumerated; otherwise cut 0 is the trivial cut
+    unsigned int get_cut_num(unsigned int gid) const { return gid < _cut_num.size() ? _cut_num[gid] : 0; }
+    const CirCut* get_cuts(unsigned int gid) const { return &_pool[_cut_begin[gid]]; }
+    size_t get_total_cut_num() const { return _pool.size(); }
+    // only with CUT_PRIORITY_DEPTH
+    unsigned int get_depth(unsigned int gid) const { return _depth[gid]; }
+    float get_flow(unsigned int gid) const { return _flow[gid]; }
+
+private:
+    unsigned int _k;
+    unsigned int _cut_limit;
+    CutPriority _priority;
+    vector<CirCut> _pool;
+    vector<size_t> _cut_begin;
+    vector<unsigned int> _cut_num;
+    vector<unsigned int> _depth;
+    vector<float> _flow;
+
+    void add_trivial_cut(unsigned int gid, bool is_const);
+    bool merge_cuts(const CirCut& a, const CirCut& b, CirCut& cut) const;
+    static uint64_t stretch_truth(const CirCut& from, const CirCut& to);
+    static void minimize_support(CirCut& cut);
+};
+
+#endif // CIR_CUT_H
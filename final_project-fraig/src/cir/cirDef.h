@@ -17,6 +17,7 @@ using namespace std;
 class CirGate;
 class CirMgr;
 class SatSolver;
+class CirCutMgr;
 
 typedef vector<CirGate*>           GateList;
 typedef vector<unsigned>           IdList;
@@ -28,6 +29,7 @@ enum GateType
    PO_GATE    = 2,
    AIG_GATE   = 3,
    CONST_GATE = 4,
+   LATCH_GATE = 5,
 
    TOT_GATE
 };
@@ -0,0 +1,251 @@
+/****************************************************************************
+  FileName     [ cirEquiv.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir combinational equivalence checking functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "sat.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// order[j] is the position in names1 of names2[j]
+// false if a name is missing or repeated, or the two lists don't have the same names
+static bool
+match_by_name(const vector<string>& names1, const vector<string>& names2, vector<size_t>& order)
+{
+    if(names1.size() != names2.size())
+        return false;
+    vector<pair<string, size_t> > sorted1, sorted2;
+    for(size_t i = 0;i < names1.size();++i)
+    {
+        sorted1.push_back(make_pair(names1[i], i));
+        sorted2.push_back(make_pair(names2[i], i));
+    }
+    sort(sorted1.begin(), sorted1.end());
+    sort(sorted2.begin(), sorted2.end());
+    order.resize(names2.size());
+    for(size_t i = 0;i < sorted1.size();++i)
+    {
+        if(sorted1[i].first.empty() || sorted1[i].first != sorted2[i].first)
+            return false;
+        if(i > 0 && sorted1[i].first == sorted1[i - 1].first)
+            return false;
+        order[sorted2[i].second] = sorted1[i].second;
+    }
+    return true;
+}
+
+// PIs/POs are matched by their symbolic names if both circuits name all of them the same way,
+// by their positions otherwise
+static void
+match_ports(const vector<string>& names1, const vector<string>& names2, vector<size_t>& order, const char* port)
+{
+    bool by_name = match_by_name(names1, names2, order);
+    if(!by_name)
+        for(size_t i = 0;i < order.size();++i)
+            order[i] = i;
+    cout << "Matching " << order.size() << " " << port << "(s) by " << (by_name ? "name" : "index") << endl;
+}
+
+/*********************************************************/
+/*   Public member functions about equivalence checking   */
+/*********************************************************/
+// The miter is written as an aag and read back, so it is built by the same parser as CIRRead.
+// Variable ids: the golden circuit keeps its own, a revised gate "g" becomes (golden M + g),
+// a revised PI becomes the matched golden PI, and each PO pair gets an XOR of 3 AIG gates after them.
+bool
+CirMgr::readMiter(const string& golden_file, const string& revised_file)
+{
+    CirMgr golden, revised;
+    if(!golden.readCircuit(golden_file) || !revised.readCircuit(revised_file))
+        return false;
+    if(golden._header_L || revised._header_L)
+    {
+        cerr << "Error: latches are not supported!!" << endl;
+        return false;
+    }
+    if(golden._pi_list.size() != revised._pi_list.size() || golden._po_list.size() != revised._po_list.size())
+    {
+        cerr << "Error: the circuits have different numbers of PIs/POs ("
+             << golden._pi_list.size() << "/" << golden._po_list.size() << " vs. "
+             << revised._pi_list.size() << "/" << revised._po_list.size() << ")!!" << endl;
+        return false;
+    }
+
+    // revised PI/PO j is matched with golden PI/PO order[j]
+    vector<string> golden_names, revised_names;
+    vector<size_t> pi_order(revised._pi_list.size()), po_order(revised._po_list.size());
+    for(size_t i = 0;i < golden._pi_list.size();++i)
+    {
+        golden_names.push_back(golden._gate_list[golden._pi_list[i]]->symbolic_name);
+        revised_names.push_back(revised._gate_list[revised._pi_list[i]]->symbolic_name);
+    }
+    match_ports(golden_names, revised_names, pi_order, "PI");
+    golden_names.clear();
+    revised_names.clear();
+    for(size_t i = 0;i < golden._po_list.size();++i)
+    {
+        golden_names.push_back(golden._gate_list[golden._po_list[i]]->symbolic_name);
+        revised_names.push_back(revised._gate_list[revised._po_list[i]]->symbolic_name);
+    }
+    match_ports(golden_names, revised_names, po_order, "PO");
+    vector<size_t> po_partner(po_order.size()); // golden PO i is matched with revised PO po_partner[i]
+    for(size_t j = 0;j < po_order.size();++j)
+        po_partner[po_order[j]] = j;
+
+    // revised variable id -> miter literal
+    unsigned int golden_M = golden._header_M;
+    vector<unsigned int> lit_map(revised._gate_list.size());
+    for(unsigned int i = 0;i < lit_map.size();++i)
+        lit_map[i] = (golden_M + i) * 2;
+    lit_map[0] = 0;
+    for(size_t j = 0;j < revised._pi_list.size();++j)
+        lit_map[revised._pi_list[j]] = golden._pi_list[pi_order[j]] * 2;
+    auto revised_lit = [&](const CirGate::RelatedGate& r)
+    { return lit_map[r.get_gate_p()->get_variable_id()] ^ (r.is_inverted() ? 1 : 0); };
+    auto golden_lit = [](const CirGate::RelatedGate& r)
+    { return r.get_gate_p()->get_variable_id() * 2 + (r.is_inverted() ? 1 : 0); };
+
+    IdList golden_aig_list, revised_aig_list;
+    for(auto& gate:golden._gate_list)
+        if(gate->get_type() == AIG_GATE)
+            golden_aig_list.push_back(gate->get_variable_id());
+    for(auto& gate:revised._gate_list)
+        if(gate->get_type() == AIG_GATE)
+            revised_aig_list.push_back(gate->get_variable_id());
+
+    size_t po_num = golden._po_list.size();
+    unsigned int xor_base = golden_M + revised._header_M + 1;
+    stringstream aag;
+    aag << "aag " << xor_base - 1 + 3 * po_num << " "
+        << golden._pi_list.size() << " 0 "
+        << po_num << " "
+        << golden_aig_list.size() + revised_aig_list.size() + 3 * po_num << '\n';
+    for(auto& e:golden._pi_list)
+        aag << e * 2 << '\n';
+    for(size_t i = 0;i < po_num;++i)
+        aag << (xor_base + 3 * i + 2) * 2 + 1 << '\n';
+    for(auto& e:golden_aig_list)
+        golden._gate_list[e]->write_as_aag(aag);
+    for(auto& e:revised_aig_list)
+    {
+        const CirGate::RelatedGateList& inputs = revised._gate_list[e]->get_i_list();
+        aag << lit_map[e] << ' ' << revised_lit(inputs[0]) << ' ' << revised_lit(inputs[1]) << '\n';
+    }
+    // f xor g = !(!(f & !g) & !(!f & g))
+    for(size_t i = 0;i < po_num;++i)
+    {
+        unsigned int f = golden_lit(golden._gate_list[golden._po_list[i]]->get_i_list()[0]);
+        unsigned int g = revised_lit(revised._gate_list[revised._po_list[po_partner[i]]]->get_i_list()[0]);
+        unsigned int x = (xor_base + 3 * i) * 2;
+        aag << x << ' ' << f << ' ' << (g ^ 1) << '\n';
+        aag << x + 2 << ' ' << (f ^ 1) << ' ' << g << '\n';
+        aag << x + 4 << ' ' << x + 1 << ' ' << x + 3 << '\n';
+    }
+    for(size_t i = 0;i < golden._pi_list.size();++i)
+    {
+        const string& name = golden._gate_list[golden._pi_list[i]]->symbolic_name;
+        if(!name.empty())
+            aag << 'i' << i << ' ' << name << '\n';
+    }
+    for(size_t i = 0;i < po_num;++i)
+    {
+        const string& name = golden._gate_list[golden._po_list[i]]->symbolic_name;
+        if(!name.empty())
+            aag << 'o' << i << ' ' << name << '\n';
+    }
+    aag << "c\nmiter of " << golden_file << " and " << revised_file << '\n';
+    return readCircuit(aag);
+}
+
+// Strash and simplify the miter (the shared logic of the two circuits merges here), find the
+// FEC groups by random simulation and sweep them with SAT (CIRFraig). A miter PO is then
+// * CONST 0 => the pair is equivalent
+// * 1 in the simulation => the pattern is a counter example
+// * otherwise => SAT on the PO, incrementally in one solver
+// Counter examples are printed in the PI order of the golden circuit (the CIRSIMulate -File format).
+// Return true if all the PO pairs are equivalent
+bool
+CirMgr::proveMiter()
+{
+    STAT_TIMER("equiv");
+    strash();
+    optimize();
+    randomSim();
+    fraig();
+
+    SatSolver solver;
+    solver.initialize();
+    vector<Var> var_list(_gate_list.size(), var_Undef);
+    var_list[0] = solver.newVar();
+    solver.assertProperty(var_list[0], false);
+
+    size_t diff_num = 0, undecided_num = 0;
+    for(size_t i = 0;i < _po_list.size();++i)
+    {
+        const CirGate* po = _gate_list[_po_list[i]];
+        const CirGate::RelatedGate& input = po->get_i_list()[0];
+        unsigned int lit = input.get_gate_p()->get_variable_id() * 2 + (input.is_inverted() ? 1 : 0);
+        string pattern;
+        lbool result = l_False;
+        if(lit == 0)
+            result = l_False;
+        else if(po->get_sim_value())
+        {
+            size_t bit = 0;
+            while(!((po->get_sim_value() >> bit) & 0x1))
+                ++bit;
+            for(auto& e:_pi_list)
+                pattern += ((_gate_list[e]->get_sim_value() >> bit) & 0x1) ? '1' : '0';
+            result = l_True;
+        }
+        else
+        {
+            result = fraig_prove(solver, var_list, 0, lit, _fraig_conflict_budget, _fraig_propagation_budget);
+            if(result == l_True)
+                for(auto& e:_pi_list) // PIs out of the cone are 0
+                    pattern += (var_list[e] != var_Undef && solver.getModelValue(var_list[e]) == l_True) ? '1' : '0';
+        }
+
+        cout << "PO " << i;
+        if(!po->symbolic_name.empty())
+            cout << " (" << po->symbolic_name << ")";
+        if(result == l_False)
+            cout << ": equivalent" << endl;
+        else if(result == l_True)
+        {
+            cout << ": NOT equivalent, counter example " << pattern << endl;
+            ++diff_num;
+        }
+        else
+        {
+            cout << ": undecided within the SAT budget" << endl;
+            ++undecided_num;
+        }
+    }
+    _fraig_sat_stats += solver.getStats();
+
+    if(diff_num)
+        cout << "Result: NOT EQUIVALENT (" << diff_num << " of " << _po_list.size() << " PO pair(s) differ)" << endl;
+    else if(undecided_num)
+        cout << "Result: UNDECIDED (" << undecided_num << " of " << _po_list.size() << " PO pair(s) undecided)" << endl;
+    else
+        cout << "Result: EQUIVALENT (" << _po_list.size() << " PO pair(s))" << endl;
+    return !diff_num && !undecided_num;
+}
@@ -7,6 +7,11 @@
 ****************************************************************************/
 
 #include <cassert>
+#include <climits>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "sat.h"
@@ -25,6 +30,7 @@ using namespace std;
 /**************************************/
 /*   Static varaibles and functions   */
 /**************************************/
+static const size_t SIM_PATTERN_NUM = sizeof(size_t) * 8;
 
 /*******************************************/
 /*   Public member functions about fraig   */
@@ -34,13 +40,272 @@ using namespace std;
 void
 CirMgr::strash()
 {
+    STAT_TIMER("strash");
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+
+    HashMap<StrashKey, unsigned int> strash_map(getHashSize(dfs_list.size()));
+    for(auto& e:dfs_list)
+    {
+        if(_gate_list[e]->get_type() != AIG_GATE)
+            continue;
+        StrashKey key(_gate_list[e]);
+        unsigned int exist_gid;
+        STAT_ADD(STAT_STRASH_PROBES, 1);
+        if(strash_map.query(key, exist_gid))
+        {
+            merge_gate(e, CirGate::RelatedGate(_gate_list[exist_gid], false));
+            if(_verbose)
+                cout << "Strashing: " << exist_gid << " merging " << e << "...\n";
+        }
+        else
+            strash_map.insert(key, e);
+    }
 }
 
+// Prove every FEC pair with SAT and merge the equivalent ones.
+// Each counter example is collected as a pattern to split the FEC groups.
+// Pairs which run out of the SAT budget are skipped and retried at the end.
+// The lowest gate of a group is the representative and pairs are proved bottom-up,
+// so the cones of the higher pairs are already simplified when they are encoded.
+// With threads, every thread owns a SatSolver and takes the next pair. The circuit
+// is only read during a batch, proven merges are rewired after all threads join.
 void
 CirMgr::fraig()
 {
+    STAT_TIMER("fraig");
+    size_t thread_num = _fraig_thread_num ? _fraig_thread_num : 1;
+    vector<SatSolver> solvers(thread_num);
+    vector<vector<Var> > var_lists(thread_num, vector<Var>(_gate_list.size(), var_Undef));
+    for(size_t i = 0;i < thread_num;++i)
+    {
+        solvers[i].initialize();
+        var_lists[i][0] = solvers[i].newVar();
+        solvers[i].assertProperty(var_lists[i][0], false);
+    }
+
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    vector<unsigned int> level_list;
+    vector<size_t> dfs_order(_gate_list.size());
+    _fraig_unresolved_list.clear();
+    vector<char> skipped(_gate_list.size(), false); // unresolved, or can't be split by simulation
+    vector<unsigned int> disproved_by(_gate_list.size(), UINT_MAX);
+    vector<size_t> pi_patterns(_pi_list.size() + _latch_list.size()); // latches are free as PIs
+    bool progress = true;
+    while(progress && !_fec_groups.empty())
+    {
+        get_level_list(dfs_list, level_list);
+        fill(dfs_order.begin(), dfs_order.end(), 0); // CONST 0 goes first
+        for(size_t i = 0;i < dfs_list.size();++i)
+            dfs_order[dfs_list[i]] = i + 1;
+        auto lower = [&](unsigned int a, unsigned int b)
+        {
+            if(level_list[a / 2] != level_list[b / 2])
+                return level_list[a / 2] < level_list[b / 2];
+            return dfs_order[a / 2] < dfs_order[b / 2];
+        };
+
+        // (representative, gate) in increasing level of the gate
+        // the representative is never in the fanout of the gate, so merging never forms a loop
+        vector<pair<unsigned int, unsigned int> > pair_list;
+        for(auto& group:_fec_groups)
+        {
+            unsigned int rep_lit = *min_element(group.begin(), group.end(), lower);
+            for(auto& lit:group)
+                if(lit != rep_lit && !skipped[lit / 2])
+                    pair_list.push_back(make_pair(rep_lit, lit));
+        }
+        sort(pair_list.begin(), pair_list.end(),
+             [&](const pair<unsigned int, unsigned int>& a, const pair<unsigned int, unsigned int>& b)
+             { return lower(a.second, b.second); });
+
+        atomic<size_t> next_pair(0);
+        atomic<size_t> pattern_num(0);
+        atomic<size_t> merge_num(0);
+        mutex result_mutex; // guards pi_patterns, merge_list and _fraig_unresolved_list
+        vector<pair<unsigned int, unsigned int> > merge_list;
+        fill(pi_patterns.begin(), pi_patterns.end(), 0);
+        fill(disproved_by.begin(), disproved_by.end(), UINT_MAX);
+
+        auto prove_pairs = [&](size_t tid)
+        {
+            SatSolver& solver = solvers[tid];
+            vector<Var>& var_list = var_lists[tid];
+            size_t i;
+            while(pattern_num < SIM_PATTERN_NUM && (i = next_pair++) < pair_list.size())
+            {
+                unsigned int rep_lit = pair_list[i].first;
+                unsigned int lit = pair_list[i].second;
+                lbool result = fraig_prove(solver, var_list, rep_lit, lit, _fraig_conflict_budget, _fraig_propagation_budget, !_fraig_dump_prefix.empty());
+                if(result == l_False)
+                {
+                    ++merge_num;
+                    if(thread_num == 1) // substitute at once
+                        fraig_merge(rep_lit, lit);
+                    else
+                    {
+                        lock_guard<mutex> lock(result_mutex);
+                        merge_list.push_back(pair_list[i]);
+                    }
+                }
+                else if(result == l_True)
+                {
+                    size_t bit = pattern_num++;
+                    if(bit >= SIM_PATTERN_NUM)
+                        break;
+                    disproved_by[lit / 2] = rep_lit / 2;
+                    lock_guard<mutex> lock(result_mutex);
+                    for(size_t k = 0;k < pi_patterns.size();++k)
+                    {
+                        unsigned int gid = k < _pi_list.size() ? _pi_list[k] : _latch_list[k - _pi_list.size()];
+                        Var v = var_list[gid]; // PIs out of the cone stay 0
+                        if(v != var_Undef && solver.getModelValue(v) == l_True)
+                            pi_patterns[k] |= ((size_t)1 << bit);
+                    }
+                }
+                else
+                {
+                    skipped[lit / 2] = true;
+                    lock_guard<mutex> lock(result_mutex);
+                    _fraig_unresolved_list.push_back(pair_list[i]);
+                }
+            }
+        };
+        if(thread_num == 1)
+            prove_pairs(0);
+        else
+        {
+            vector<thread> threads;
+            for(size_t i = 0;i < thread_num;++i)
+                threads.push_back(thread(prove_pairs, i));
+            for(auto& t:threads)
+                t.join();
+        }
+
+        // rewire in topological order
+        sort(merge_list.begin(), merge_list.end(),
+             [&](const pair<unsigned int, unsigned int>& a, const pair<unsigned int, unsigned int>& b)
+             { return lower(a.second, b.second); });
+        for(auto& e:merge_list)
+            fraig_merge(e.first, e.second);
+        size_t sat_num = pattern_num < SIM_PATTERN_NUM ? (size_t)pattern_num : SIM_PATTERN_NUM;
+        progress = sat_num || merge_num;
+
+        // merged gates are removed and counter examples split the groups
+        dfs_list.clear();
+        get_dfs_list(dfs_list);
+        if(sat_num)
+            sim_patterns(pi_patterns, dfs_list);
+        sim_update_fec_groups(dfs_list);
+        // floating gates are 0 in simulation but free in SAT, such pairs are not split
+        for(auto& group:_fec_groups)
+            for(auto& lit:group)
+                if(disproved_by[lit / 2] != UINT_MAX)
+                    for(auto& rep_lit:group)
+                        if(rep_lit / 2 == disproved_by[lit / 2])
+                            skipped[lit / 2] = true;
+        if(_verbose)
+            cout << "Updating by " << (sat_num ? "SAT" : "UNSAT") << "... Total #FEC Group = " << _fec_groups.size() << endl;
+    }
+
+    // retry the hard pairs with a larger budget
+    if(_fraig_retry_budget != 0 && !_fraig_unresolved_list.empty())
+    {
+        vector<pair<unsigned int, unsigned int> > retry_list;
+        retry_list.swap(_fraig_unresolved_list);
+        solvers[0].setPortfolio(_fraig_portfolio_num);
+        for(auto& e:retry_list)
+        {
+            const CirGate* rep_gate = _gate_list[e.first / 2];
+            const CirGate* gate = _gate_list[e.second / 2];
+            if(rep_gate->get_type() == UNDEF_GATE || gate->get_type() == UNDEF_GATE)
+                continue;
+            size_t diff = rep_gate->get_sim_value() ^ gate->get_sim_value();
+            if(diff != ((e.first ^ e.second) % 2 ? ~(size_t)0 : 0)) // split by later counter examples
+                continue;
+            lbool result = fraig_prove(solvers[0], var_lists[0], e.first, e.second, _fraig_retry_budget, -1);
+            if(result == l_False)
+                fraig_merge(e.first, e.second);
+            else if(result == l_Undef)
+                _fraig_unresolved_list.push_back(e);
+        }
+    }
+    if(!_fraig_unresolved_list.empty())
+        cout << "Fraig: " << _fraig_unresolved_list.size() << " pair(s) unresolved within the SAT budget" << endl;
+
+    _fraig_sat_stats = SatStats();
+    for(auto& solver:solvers)
+        _fraig_sat_stats += solver.getStats();
+
+    _fec_groups.clear();
+    _fec_initialized = false;
 }
 
 /********************************************/
 /*   Private member functions about fraig   */
 /********************************************/
+// Encode the cone of gid which is not in the solver yet; CONST 0 must be encoded first
+// Use an explicit stack instead of the visited flags, other threads may be encoding too
+void
+CirMgr::fraig_gen_proof_model(SatSolver& solver, vector<Var>& var_list, unsigned int gid) const
+{
+    IdList stack(1, gid);
+    while(!stack.empty())
+    {
+        unsigned int e = stack.back();
+        if(var_list[e] != var_Undef)
+        {
+            stack.pop_back();
+            continue;
+        }
+        const CirGate* gate = _gate_list[e];
+        if(gate->get_type() != AIG_GATE) // PI or floating UNDEF gate
+        {
+            var_list[e] = solver.newVar();
+            stack.pop_back();
+            continue;
+        }
+        const CirGate::RelatedGate& ia = gate->get_i_list()[0];
+        const CirGate::RelatedGate& ib = gate->get_i_list()[1];
+        unsigned int a = ia.get_gate_p()->get_variable_id();
+        unsigned int b = ib.get_gate_p()->get_variable_id();
+        if(var_list[a] == var_Undef || var_list[b] == var_Undef)
+        {
+            stack.push_back(a);
+            stack.push_back(b);
+            continue;
+        }
+        var_list[e] = solver.newVar();
+        solver.addAigCNF(var_list[e], var_list[a], ia.is_inverted(), var_list[b], ib.is_inverted());
+        stack.pop_back();
+    }
+}
+
+// SAT on (rep_lit xor lit), l_False means they are equivalent
+// if dump, an out-of-budget query is written to "<_fraig_dump_prefix>_<rep>_<gate>.cnf"
+lbool
+CirMgr::fraig_prove(SatSolver& solver, vector<Var>& var_list, unsigned int rep_lit, unsigned int lit, int64 conflicts, int64 propagations, bool dump) const
+{
+    fraig_gen_proof_model(solver, var_list, rep_lit / 2);
+    fraig_gen_proof_model(solver, var_list, lit / 2);
+    // the miter only lives for this query, so it is a clause group released right after the solve
+    Var miter = solver.newGroup();
+    solver.addGroupXorCNF(miter, var_list[rep_lit / 2], rep_lit % 2, var_list[lit / 2], lit % 2);
+    solver.assumeRelease();
+    solver.enableGroup(miter);
+    lbool result = solver.assumpSolveLimited(conflicts, propagations);
+    if(dump && result == l_Undef)
+        solver.writeDimacs(_fraig_dump_prefix + "_" + to_string(rep_lit / 2) + "_" + to_string(lit / 2) + ".cnf");
+    solver.releaseGroup(miter); // (the model of a SAT result is kept)
+    return result;
+}
+
+void
+CirMgr::fraig_merge(unsigned int rep_lit, unsigned int lit)
+{
+    bool inverted = (rep_lit ^ lit) % 2;
+    merge_gate(lit / 2, CirGate::RelatedGate(_gate_list[rep_lit / 2], inverted));
+    if(_verbose)
+        cout << "Fraig: " << rep_lit / 2 << " merging " << (inverted ? "!" : "") << lit / 2 << "...\n";
+}
@@ -30,9 +30,12 @@ CirGate::print_net_dfs(unsigned int& print_line_no) const
         return;
     set_visited();
 
-    for(const RelatedGate& e:_i_gate_list)
+    if(get_type() != LATCH_GATE) // the next state is printed after the POs
     {
-        e.get_gate_p()->print_net_dfs(print_line_no);
+        for(const RelatedGate& e:_i_gate_list)
+        {
+            e.get_gate_p()->print_net_dfs(print_line_no);
+        }
     }
     print_net(print_line_no);
 }
@@ -51,8 +54,20 @@ CirGate::reportGate() const
 
     cout << string(times, '=') << endl;
     cout << "= "  << left << setw(times - 4) << ss.str() << endl;
-    cout << "= FECs:" << endl;
-    cout << "= Value: 00000000_00000000_00000000_00000000_00000000_00000000_00000000_00000000" << endl;
+    IdList partners;
+    cirMgr->get_fec_partners(get_variable_id(), partners);
+    cout << "= FECs:";
+    for(auto& lit:partners)
+        cout << " " << (lit % 2 ? "!" : "") << lit / 2;
+    cout << endl;
+    cout << "= Value: ";
+    for(int i = sizeof(size_t) * 8 - 1;i >= 0;--i)
+    {
+        cout << ((get_sim_value() >> i) & 0x1);
+        if(i % 8 == 0 && i != 0)
+            cout << "_";
+    }
+    cout << endl;
     cout << string(times, '=') << endl;
 }
 
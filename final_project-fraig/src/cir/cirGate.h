@@ -33,6 +33,7 @@ public:
         void set_inverted(bool new_inverted) { if(new_inverted) value |= 0x1; else value &= ~(0x1); }
         void set_inverted_reverse() { set_inverted(!is_inverted()); }
         void set_pointer(CirGate* new_p) { value &= 0x1; value |= (size_t)new_p; }
+        size_t get_sim_value() const { return (is_inverted() ? ~get_gate_p()->get_sim_value() : get_gate_p()->get_sim_value()); }
 
     private:
         size_t value;
@@ -40,11 +41,11 @@ public:
     using RelatedGateList = vector<RelatedGate>;    // [TODO] change to map
 
     CirGate() {}
-    CirGate(const unsigned int& vid, const unsigned int& lno): _variable_id(vid), _line_no(lno), visited(0) {}
+    CirGate(const unsigned int& vid, const unsigned int& lno): _variable_id(vid), _line_no(lno), visited(0), _sim_value(0) {}
     CirGate(const unsigned int& vid,
             const unsigned int& lno,
             const RelatedGateList& i_list,
-            const RelatedGateList& o_list): _i_gate_list(i_list), _o_gate_list(o_list), _variable_id(vid), _line_no(lno), visited(0) {}
+            const RelatedGateList& o_list): _i_gate_list(i_list), _o_gate_list(o_list), _variable_id(vid), _line_no(lno), visited(0), _sim_value(0) {}
 
     virtual ~CirGate() {}
 
@@ -54,19 +55,21 @@ public:
     static void reset_visited() { ++visited_ref; }
     bool is_visited() const { return (visited == visited_ref); }
     void set_visited() const { visited = visited_ref; }
+    // a latch is a source, its next state is not in its dfs list
     void get_dfs_list(IdList& list) const
     {
         if(get_type() == UNDEF_GATE || is_visited())
             return;
         set_visited();
-        for(auto &e:_i_gate_list)
-            e.get_gate_p()->get_dfs_list(list);
+        if(get_type() != LATCH_GATE)
+            for(auto &e:_i_gate_list)
+                e.get_gate_p()->get_dfs_list(list);
         list.push_back(get_variable_id());
     }
 
     // check status
     bool is_floating() const;
-    bool is_not_using() const { return (get_type() == PI_GATE || get_type() == AIG_GATE) && _o_gate_list.empty(); }
+    bool is_not_using() const { return (get_type() == PI_GATE || get_type() == AIG_GATE || get_type() == LATCH_GATE) && _o_gate_list.empty(); }
     virtual bool isAig() const { return false; }
 
     // Basic access methods
@@ -85,6 +88,12 @@ public:
     void replace_self_in_related_gates(bool is_input, const RelatedGate& new_relation) const;
     void replace_relation(const bool in_i_gate_list, const CirGate* ori_gate_p, const RelatedGate& new_relation);
 
+    // for CIRSIMulate
+    // 64 patterns are simulated at the same time, one pattern per bit
+    size_t get_sim_value() const { return _sim_value; }
+    void set_sim_value(size_t new_value) { _sim_value = new_value; }
+    virtual void simulate() {} // evaluate _sim_value from the input list
+
     // for CIRWrite
     void write_aig_dfs(IdList& _aig_list);
     virtual void write_as_aag(ostream& outfile) const { cerr << "write_as_aag(ostream&) in CirGate class should not be called\n"; }
@@ -135,6 +144,7 @@ private:
     unsigned int _line_no;
     mutable unsigned int visited;
     static unsigned int visited_ref;
+    size_t _sim_value;
 };
 
 class PIGate: public CirGate
@@ -175,6 +185,8 @@ public:
     GateType get_type() const { return PO_GATE; }
     string get_type_str() const { return "PO"; }
 
+    void simulate() { set_sim_value(_i_gate_list[0].get_sim_value()); }
+
     void write_as_aag(ostream& outfile) const { outfile << _i_gate_list[0].get_gate_p()->get_variable_id() * 2 + (_i_gate_list[0].is_inverted() ? 1 : 0) << '\n'; }
     unsigned int write_get_input_gate_id() const { return _i_gate_list[0].get_gate_p()->get_variable_id(); } // for CirMgr::write
     void print_net(unsigned int& print_line_no) const
@@ -201,6 +213,51 @@ public:
 private:
 };
 
+class LATCHGate: public CirGate
+{
+public:
+    LATCHGate(const unsigned int& vid, const unsigned int& lno, unsigned int reset = 0): CirGate(vid, lno), _reset(reset) {}
+    LATCHGate(const unsigned int& vid,
+              const unsigned int& lno,
+              const RelatedGateList& i_list,
+              const RelatedGateList& o_list,
+              unsigned int reset = 0): CirGate(vid, lno, i_list, o_list), _reset(reset) {}
+
+    GateType get_type() const { return LATCH_GATE; }
+    string get_type_str() const { return "LATCH"; }
+
+    // the input is the next state; the initial state is 0, 1 or its own literal if uninitialized (AIGER 1.9)
+    unsigned int get_reset() const { return _reset; }
+    bool is_initialized() const { return _reset <= 1; }
+
+    void write_as_aag(ostream& outfile) const
+    {
+        outfile << get_variable_id() * 2 << ' '
+                << _i_gate_list[0].get_gate_p()->get_variable_id() * 2 + (_i_gate_list[0].is_inverted() ? 1 : 0);
+        if(_reset)
+            outfile << ' ' << _reset;
+        outfile << '\n';
+    }
+    unsigned int write_get_input_gate_id() const { return _i_gate_list[0].get_gate_p()->get_variable_id(); } // for CirMgr::write
+    void print_net(unsigned int& print_line_no) const
+    {
+        cout << "[" << print_line_no << "] ";
+        cout << get_type_str() << " ";
+        cout << get_variable_id() << " ";
+        if(_i_gate_list[0].get_gate_p()->get_type() == UNDEF_GATE)
+            cout << "*";
+        if(_i_gate_list[0].is_inverted())
+            cout << "!";
+        cout << _i_gate_list[0].get_gate_p()->get_variable_id();
+        if(!symbolic_name.empty())
+            cout << " (" << symbolic_name << ")";
+        cout << endl;
+        ++print_line_no;
+    }
+private:
+    unsigned int _reset;
+};
+
 class AIGGate: public CirGate
 {
 public:
@@ -215,6 +272,8 @@ public:
 
     bool isAig() const { return true; }
 
+    void simulate() { set_sim_value(_i_gate_list[0].get_sim_value() & _i_gate_list[1].get_sim_value()); }
+
     void write_as_aag(ostream& outfile) const { outfile << get_variable_id() * 2 << ' '
                                                         << _i_gate_list[0].get_gate_p()->get_variable_id() * 2 + (_i_gate_list[0].is_inverted() ? 1 : 0) << ' '
                                                         << _i_gate_list[1].get_gate_p()->get_variable_id() * 2 + (_i_gate_list[1].is_inverted() ? 1 : 0) << '\n'; }
@@ -282,5 +341,31 @@ public:
 private:
 };
 
+// HashKey for strash, two AIG gates with the same (unordered) input literals are equivalent
+class StrashKey
+{
+public:
+    StrashKey(): _key(0) {}
+    StrashKey(size_t lit_a, size_t lit_b)
+    {
+        if(lit_a > lit_b)
+            swap(lit_a, lit_b);
+        _key = (lit_a << 32) | lit_b;
+    }
+    StrashKey(const CirGate* gate)
+    {
+        size_t lit[2];
+        for(size_t i = 0;i < 2;++i)
+        {
+            const CirGate::RelatedGate& input = gate->get_i_list()[i];
+            lit[i] = input.get_gate_p()->get_variable_id() * 2 + (input.is_inverted() ? 1 : 0);
+        }
+        *this = StrashKey(lit[0], lit[1]);
+    }
+    size_t operator() () const { return _key; }
+    bool operator == (const StrashKey& k) const { return _key == k._key; }
+private:
+    size_t _key;
+};
 
 #endif // CIR_GATE_H
@@ -0,0 +1,396 @@
+/****************************************************************************
+  FileName     [ cirMap.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir k-LUT technology mapping functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirCut.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const unsigned int MAP_FLOW_ROUNDS = 1;  // area flow recovery passes
+static const unsigned int MAP_EXACT_ROUNDS = 2; // exact area recovery passes
+
+// The cut of every AIG gate used if the gate is a LUT, chosen from its priority cuts.
+// The arrival time of a gate is the depth of its LUT (PIs are 0), the required time is how late it
+// can arrive without raising the depth of the mapping. Area recovery only chooses the cuts which
+// arrive in time, so the depth of the first (depth-optimal) mapping is kept.
+class LutMapper
+{
+public:
+    enum Mode
+    {
+        MAP_DEPTH,      // the lowest arrival time, then the least area flow
+        MAP_AREA_FLOW,  // the least area flow in time
+        MAP_EXACT_AREA  // the fewest LUTs added to the current mapping in time
+    };
+
+    LutMapper(const GateList& gate_list, const IdList& dfs_list, const IdList& sink_list, const CirCutMgr& cut_mgr);
+
+    void select_cuts(Mode mode);
+    size_t get_lut_num() const { return _lut_num; }
+    unsigned int get_depth() const { return _depth; }
+    // a LUT of the mapping
+    bool is_mapped(unsigned int gid) const { return is_lut(gid) && _refs[gid] > 0; }
+    const CirCut& get_cut(unsigned int gid) const { return _cut_mgr.get_cuts(gid)[_best[gid]]; }
+
+private:
+    const GateList& _gate_list;
+    const IdList& _dfs_list;
+    const IdList& _sink_list;        // POs and latches, gates which need their input 0
+    const CirCutMgr& _cut_mgr;
+
+    vector<unsigned int> _best;      // index of the cut
+    vector<unsigned int> _arrival;
+    vector<unsigned int> _required;  // UINT_MAX if not in the mapping
+    vector<unsigned int> _refs;      // fanouts in the mapping (LUTs and POs)
+    vector<float> _est_refs;         // fanouts expected in the next mapping, for area flow
+    vector<float> _area_flow;        // area flow of the gate divided by its expected fanouts
+    IdList _stack;
+    size_t _lut_num;
+    unsigned int _depth;
+
+    // an AIG gate with cuts, may be a LUT
+    bool is_lut(unsigned int gid) const { return _gate_list[gid]->get_type() == AIG_GATE && _cut_mgr.get_cut_num(gid) > 1; }
+    unsigned int cut_arrival(const CirCut& cut) const;
+    float cut_area_flow(const CirCut& cut) const;
+    unsigned int ref_cut(const CirCut& cut);
+    unsigned int deref_cut(const CirCut& cut);
+    void set_refs();
+    void set_required();
+};
+
+LutMapper::LutMapper(const GateList& gate_list, const IdList& dfs_list, const IdList& sink_list, const CirCutMgr& cut_mgr):
+    _gate_list(gate_list), _dfs_list(dfs_list), _sink_list(sink_list), _cut_mgr(cut_mgr),
+    _best(gate_list.size(), 0), _arrival(gate_list.size(), 0), _required(gate_list.size(), UINT_MAX),
+    _refs(gate_list.size(), 0), _est_refs(gate_list.size(), 1), _area_flow(gate_list.size(), 0),
+    _lut_num(0), _depth(0)
+{
+    for(auto& e:_dfs_list)
+        if(_gate_list[e]->get_o_list().size() > 1)
+            _est_refs[e] = _gate_list[e]->get_o_list().size();
+}
+
+// Choose the cut of every AIG gate in topological order, then update the mapping from the POs
+// With MAP_EXACT_AREA, a gate of the mapping gives up its cut before trying the others, so the
+// LUTs only used by it are counted again
+void
+LutMapper::select_cuts(Mode mode)
+{
+    if(mode == MAP_AREA_FLOW)
+        for(auto& e:_dfs_list)
+            _est_refs[e] = std::max(1.0f, (2 * _est_refs[e] + _refs[e]) / 3);
+
+    for(auto& e:_dfs_list)
+    {
+        if(!is_lut(e))
+            continue;
+        bool mapped = mode == MAP_EXACT_AREA && _refs[e] > 0;
+        if(mapped)
+            deref_cut(get_cut(e));
+
+        const CirCut* cuts = _cut_mgr.get_cuts(e);
+        unsigned int best = 0, best_arrival = UINT_MAX;
+        float best_cost = 0;
+        for(unsigned int i = 1;i < _cut_mgr.get_cut_num(e);++i)
+        {
+            unsigned int arrival = cut_arrival(cuts[i]);
+            if(mode != MAP_DEPTH && arrival > _required[e])
+                continue;
+            float cost = 0;
+            if(mode == MAP_EXACT_AREA)
+            {
+                cost = ref_cut(cuts[i]);
+                deref_cut(cuts[i]);
+            }
+            else
+                cost = cut_area_flow(cuts[i]);
+            bool better = best == 0;
+            if(!better && mode == MAP_DEPTH)
+                better = arrival < best_arrival || (arrival == best_arrival && cost < best_cost);
+            else if(!better)
+                better = cost < best_cost || (cost == best_cost && arrival < best_arrival);
+            if(better)
+            {
+                best = i;
+                best_arrival = arrival;
+                best_cost = cost;
+            }
+        }
+        if(best == 0) // no cut in time, the lowest arrival
+        {
+            for(unsigned int i = 1;i < _cut_mgr.get_cut_num(e);++i)
+            {
+                unsigned int arrival = cut_arrival(cuts[i]);
+                if(arrival < best_arrival)
+                {
+                    best = i;
+                    best_arrival = arrival;
+                }
+            }
+        }
+        _best[e] = best;
+        _arrival[e] = best_arrival;
+        _area_flow[e] = cut_area_flow(cuts[best]) / _est_refs[e];
+
+        if(mapped)
+            ref_cut(get_cut(e));
+    }
+    set_refs();
+    set_required();
+}
+
+unsigned int
+LutMapper::cut_arrival(const CirCut& cut) const
+{
+    unsigned int arrival = 0;
+    for(unsigned int i = 0;i < cut.size();++i)
+        arrival = std::max(arrival, _arrival[cut.leaf(i)]);
+    return arrival + 1;
+}
+
+float
+LutMapper::cut_area_flow(const CirCut& cut) const
+{
+    float flow = 1;
+    for(unsigned int i = 0;i < cut.size();++i)
+        flow += _area_flow[cut.leaf(i)];
+    return flow;
+}
+
+// add a reference to the leaves of the cut, the LUTs which were not used before are added to the
+// mapping with their cuts; the number of the LUTs added (with the cut itself)
+unsigned int
+LutMapper::ref_cut(const CirCut& cut)
+{
+    unsigned int area = 1;
+    const CirCut* c = &cut;
+    _stack.clear();
+    while(true)
+    {
+        for(unsigned int i = 0;i < c->size();++i)
+        {
+            unsigned int g = c->leaf(i);
+            if(is_lut(g) && _refs[g]++ == 0)
+            {
+                ++area;
+                _stack.push_back(g);
+            }
+        }
+        if(_stack.empty())
+            break;
+        c = &get_cut(_stack.back());
+        _stack.pop_back();
+    }
+    return area;
+}
+
+// the reverse of ref_cut()
+unsigned int
+LutMapper::deref_cut(const CirCut& cut)
+{
+    unsigned int area = 1;
+    const CirCut* c = &cut;
+    _stack.clear();
+    while(true)
+    {
+        for(unsigned int i = 0;i < c->size();++i)
+        {
+            unsigned int g = c->leaf(i);
+            if(is_lut(g) && --_refs[g] == 0)
+            {
+                ++area;
+                _stack.push_back(g);
+            }
+        }
+        if(_stack.empty())
+            break;
+        c = &get_cut(_stack.back());
+        _stack.pop_back();
+    }
+    return area;
+}
+
+void
+LutMapper::set_refs()
+{
+    fill(_refs.begin(), _refs.end(), 0);
+    _lut_num = 0;
+    for(auto& e:_sink_list)
+    {
+        unsigned int g = _gate_list[e]->get_i_list()[0].get_gate_p()->get_variable_id();
+        if(is_lut(g) && _refs[g]++ == 0)
+            _lut_num += ref_cut(get_cut(g));
+    }
+}
+
+// all POs and next states are required at the depth of the mapping
+void
+LutMapper::set_required()
+{
+    _depth = 0;
+    for(auto& e:_sink_list)
+        _depth = std::max(_depth, _arrival[_gate_list[e]->get_i_list()[0].get_gate_p()->get_variable_id()]);
+    fill(_required.begin(), _required.end(), UINT_MAX);
+    for(auto& e:_sink_list)
+        _required[_gate_list[e]->get_i_list()[0].get_gate_p()->get_variable_id()] = _depth;
+    for(size_t i = _dfs_list.size();i-- > 0;)
+    {
+        unsigned int e = _dfs_list[i];
+        if(!is_mapped(e))
+            continue;
+        const CirCut& cut = get_cut(e);
+        for(unsigned int j = 0;j < cut.size();++j)
+            _required[cut.leaf(j)] = std::min(_required[cut.leaf(j)], _required[e] - 1);
+    }
+}
+
+/*********************************************/
+/*   Public member functions about mapping   */
+/*********************************************/
+// Depth-optimal mapping over the priority cuts (ranked by depth and area flow), then area
+// recovery by area flow and by exact area with the depth kept.
+// The mapping is written to "blif" as one .names (the cover of its truth table, on-set or
+// off-set) per LUT, a buffer or an inverter per PO and per next state, and a .latch per latch.
+void
+CirMgr::mapLut(unsigned int k, unsigned int cut_limit, ostream* blif) const
+{
+    STAT_TIMER("map");
+    CirCutMgr cut_mgr(k, cut_limit, CUT_PRIORITY_DEPTH);
+    get_cuts(cut_mgr);
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+
+    IdList sink_list(_po_list);
+    sink_list.insert(sink_list.end(), _latch_list.begin(), _latch_list.end());
+    LutMapper mapper(_gate_list, dfs_list, sink_list, cut_mgr);
+    mapper.select_cuts(LutMapper::MAP_DEPTH);
+    if(_verbose)
+        cout << "Depth-optimal mapping: " << mapper.get_lut_num() << " LUT(s), depth " << mapper.get_depth() << endl;
+    for(unsigned int i = 0;i < MAP_FLOW_ROUNDS;++i)
+    {
+        mapper.select_cuts(LutMapper::MAP_AREA_FLOW);
+        if(_verbose)
+            cout << "Area flow recovery: " << mapper.get_lut_num() << " LUT(s), depth " << mapper.get_depth() << endl;
+    }
+    for(unsigned int i = 0;i < MAP_EXACT_ROUNDS;++i)
+    {
+        mapper.select_cuts(LutMapper::MAP_EXACT_AREA);
+        if(_verbose)
+            cout << "Exact area recovery: " << mapper.get_lut_num() << " LUT(s), depth " << mapper.get_depth() << endl;
+    }
+
+    vector<size_t> size_count(k + 1, 0);
+    for(auto& e:dfs_list)
+        if(mapper.is_mapped(e))
+            ++size_count[mapper.get_cut(e).size()];
+    cout << endl;
+    cout << "LUT Mapping (k = " << k << ", " << cut_limit << " cuts per gate)" << endl;
+    cout << "==================" << endl;
+    cout << "  LUT          " << setw(12) << right << mapper.get_lut_num() << endl;
+    for(unsigned int i = 0;i <= k;++i)
+        if(size_count[i])
+            cout << "    " << i << " inputs   " << setw(12) << right << size_count[i] << endl;
+    cout << "  Depth        " << setw(12) << right << mapper.get_depth() << endl;
+    if(!blif)
+        return;
+
+    // PI i is i<i>, PO i is o<i>, the next state of latch i is l<i>, the other gates (the
+    // latches, CONST 0 and the LUT outputs) are n<gid>; the .aag symbol table is not used
+    vector<string> pi_name(_gate_list.size());
+    for(size_t i = 0;i < _pi_list.size();++i)
+        pi_name[_pi_list[i]] = "i" + to_string(i);
+    auto net_name = [&](unsigned int gid)
+    { return _gate_list[gid]->get_type() == PI_GATE ? pi_name[gid] : "n" + to_string(gid); };
+    (*blif) << ".model fraig\n";
+    (*blif) << ".inputs";
+    for(auto& e:_pi_list)
+        (*blif) << ' ' << net_name(e);
+    (*blif) << "\n.outputs";
+    for(size_t i = 0;i < _po_list.size();++i)
+        (*blif) << " o" << i;
+    (*blif) << '\n';
+
+    // CONST 0 and the floating gates are constant 0 (.names without rows)
+    vector<bool> used(_gate_list.size(), false);
+    for(auto& e:dfs_list)
+    {
+        if(!mapper.is_mapped(e))
+            continue;
+        const CirCut& cut = mapper.get_cut(e);
+        for(unsigned int i = 0;i < cut.size();++i)
+            used[cut.leaf(i)] = true;
+    }
+    for(auto& e:sink_list)
+        used[_gate_list[e]->get_i_list()[0].get_gate_p()->get_variable_id()] = true;
+    for(size_t i = 0;i < _gate_list.size();++i)
+        if(used[i] && (_gate_list[i]->get_type() == CONST_GATE || _gate_list[i]->get_type() == UNDEF_GATE))
+            (*blif) << ".names " << net_name(i) << '\n';
+
+    for(auto& e:dfs_list)
+    {
+        if(!mapper.is_mapped(e))
+            continue;
+        const CirCut& cut = mapper.get_cut(e);
+        (*blif) << ".names";
+        for(unsigned int i = 0;i < cut.size();++i)
+            (*blif) << ' ' << net_name(cut.leaf(i));
+        (*blif) << ' ' << net_name(e) << '\n';
+        // the smaller of the on-set and the off-set
+        unsigned int pattern_num = 1 << cut.size();
+        unsigned int one_num = 0;
+        for(unsigned int p = 0;p < pattern_num;++p)
+            one_num += (cut.truth() >> p) & 0x1;
+        bool on_set = one_num * 2 <= pattern_num;
+        if(one_num == 0 || one_num == pattern_num)
+        {
+            if(one_num)
+                (*blif) << "1\n";
+            continue;
+        }
+        for(unsigned int p = 0;p < pattern_num;++p)
+        {
+            if(((cut.truth() >> p) & 0x1) != on_set)
+                continue;
+            for(unsigned int i = 0;i < cut.size();++i)
+                (*blif) << ((p >> i) & 0x1);
+            (*blif) << ' ' << (on_set ? 1 : 0) << '\n';
+        }
+    }
+    for(size_t i = 0;i < _po_list.size();++i)
+    {
+        const CirGate* gate = _gate_list[_po_list[i]];
+        const CirGate::RelatedGate& input = gate->get_i_list()[0];
+        (*blif) << ".names " << net_name(input.get_gate_p()->get_variable_id()) << " o" << i << '\n';
+        (*blif) << (input.is_inverted() ? "0 1\n" : "1 1\n");
+    }
+    // the next state of latch i is l<i>, an uninitialized latch is a don't care (2)
+    for(size_t i = 0;i < _latch_list.size();++i)
+    {
+        const LATCHGate* latch = static_cast<const LATCHGate*>(_gate_list[_latch_list[i]]);
+        const CirGate::RelatedGate& input = latch->get_i_list()[0];
+        (*blif) << ".names " << net_name(input.get_gate_p()->get_variable_id()) << " l" << i << '\n';
+        (*blif) << (input.is_inverted() ? "0 1\n" : "1 1\n");
+        (*blif) << ".latch l" << i << ' ' << net_name(_latch_list[i]) << ' '
+                << (latch->is_initialized() ? latch->get_reset() : 2) << '\n';
+    }
+    (*blif) << ".end\n";
+}
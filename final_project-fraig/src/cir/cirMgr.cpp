@@ -156,7 +156,7 @@ CirGate* CirMgr::getGate(unsigned gid) const
 /**************************************************************/
 /*   class CirMgr member functions for circuit construction   */
 /**************************************************************/
-CirMgr::CirMgr() { }
+CirMgr::CirMgr(): _simLog(0), _fec_initialized(false), _fraig_conflict_budget(-1), _fraig_propagation_budget(-1), _fraig_retry_budget(0), _fraig_thread_num(1), _fraig_portfolio_num(1), _verbose(true) { }
 CirMgr::~CirMgr()
 {
     for(size_t i = 0;i < _gate_list.size();++i)
@@ -172,7 +172,12 @@ CirMgr::readCircuit(const string& fileName)
         cerr << "Cannot open design \"" << fileName << "\"!!" << endl;
         return false;
     }
-
+    return readCircuit(aag_file);
+}
+bool
+CirMgr::readCircuit(istream& aag_file)
+{
+    STAT_TIMER("read");
     vector<int> tokens;
     string input_line;
     unsigned int line_no = 0;
@@ -211,7 +216,18 @@ CirMgr::readCircuit(const string& fileName)
     }
 
     // Latches
-    // no implement
+    //clog << "READ LATCHES" << endl;
+    for(unsigned int i = 0;i < _header_L;++i)
+    {
+        tokens.clear();
+        getline(aag_file, input_line);
+        if(!read_gate_parser(input_line, tokens, LATCH_GATE)) // TODO error
+        {
+            return false;
+        }
+        ++line_no;
+        read_init_add_gate(LATCH_GATE, line_no, tokens);
+    }
 
     // Outputs
     //clog << "READ OUTPUTS" << endl;
@@ -243,7 +259,7 @@ CirMgr::readCircuit(const string& fileName)
     }
 
     // Symbols
-    while(getline(aag_file, input_line) && (input_line[0] == 'i' || input_line[0] == 'o'))
+    while(getline(aag_file, input_line) && (input_line[0] == 'i' || input_line[0] == 'l' || input_line[0] == 'o'))
     {
         CirGate* target;
         string symbolic_name;
@@ -260,7 +276,6 @@ CirMgr::readCircuit(const string& fileName)
         }
     }
 
-    aag_file.close();
     return true;
 }
 
@@ -284,9 +299,11 @@ CirMgr::printSummary() const
     cout << "==================" << endl;
     cout << "  PI   " << setw(9) << right << _header_I << endl;
     cout << "  PO   " << setw(9) << right << _header_O << endl;
+    if(_header_L)
+        cout << "  LATCH" << setw(9) << right << _header_L << endl;
     cout << "  AIG  " << setw(9) << right << _header_A << endl;
     cout << "------------------" << endl;
-    cout << "  Total" << setw(9) << right << _header_I + _header_O + _header_A << endl;
+    cout << "  Total" << setw(9) << right << _header_I + _header_O + _header_L + _header_A << endl;
 
 #ifdef DEBUG
    for(size_t i = 0;i < _gate_list.size();++i)
@@ -308,6 +325,11 @@ CirMgr::printNetlist() const
     {
         _gate_list[e]->print_net_dfs(print_line_no);
     }
+    for(auto e:_latch_list) // the next states
+    {
+        _gate_list[_gate_list[e]->write_get_input_gate_id()]->print_net_dfs(print_line_no);
+        _gate_list[e]->print_net_dfs(print_line_no);
+    }
 }
 
 void
@@ -369,6 +391,11 @@ CirMgr::writeAag(ostream& outfile) const
         unsigned int input_gate_id = _gate_list[e]->write_get_input_gate_id();
         _gate_list[input_gate_id]->write_aig_dfs(_aig_list);
     }
+    for(const unsigned int& e:_latch_list)
+    {
+        unsigned int input_gate_id = _gate_list[e]->write_get_input_gate_id();
+        _gate_list[input_gate_id]->write_aig_dfs(_aig_list);
+    }
     outfile << "aag " << _header_M << " "
                       << _header_I << " "
                       << _header_L << " "
@@ -380,6 +407,8 @@ CirMgr::writeAag(ostream& outfile) const
         _gate_list[e]->write_as_aag(outfile);
 
     // latches
+    for(const unsigned int& e:_latch_list)
+        _gate_list[e]->write_as_aag(outfile);
 
     // output
     for(const unsigned int& e:_po_list)
@@ -397,6 +426,13 @@ CirMgr::writeAag(ostream& outfile) const
             continue;
         outfile << 'i' << i << ' ' << _gate_list[e]->symbolic_name << '\n';
     }
+    for(size_t i = 0;i < _latch_list.size();++i)
+    {
+        const unsigned int& e = _latch_list[i];
+        if(_gate_list[e]->symbolic_name.empty())
+            continue;
+        outfile << 'l' << i << ' ' << _gate_list[e]->symbolic_name << '\n';
+    }
     for(size_t i = 0;i < _po_list.size();++i)
     {
         const unsigned int& e = _po_list[i];
@@ -423,6 +459,10 @@ bool CirMgr::read_symbol_parser(string input, CirGate*& target, string& symbolic
     {
         target = _gate_list[_pi_list[position]];
     }
+    else if(ch == 'l')
+    {
+        target = _gate_list[_latch_list[position]];
+    }
     else if(ch == 'o')
     {
         target = _gate_list[_po_list[position]];
@@ -476,6 +516,11 @@ bool CirMgr::read_gate_parser(const string& input, vector<int>& tokens, GateType
         case PI_GATE:
         case PO_GATE:
             return read_interger_parser(input, tokens, 1);
+        case LATCH_GATE: // "lit next" or "lit next reset"
+            if(read_interger_parser(input, tokens, 2))
+                return true;
+            tokens.clear();
+            return read_interger_parser(input, tokens, 3);
         case AIG_GATE:
             return read_interger_parser(input, tokens, 3);
         default:
@@ -543,6 +588,24 @@ void CirMgr::read_init_add_gate(GateType type, unsigned int lno, const vector<in
 
         _po_list.push_back(the_gate_id);
     }
+    else if(type == LATCH_GATE)
+    {
+        unsigned int the_gate_id = literal_to_variable(tokens[0]);
+// ##########################################################################################
+        if(_gate_list[the_gate_id]->get_type() != UNDEF_GATE) // TODO error corruption
+            return;
+// ##########################################################################################
+        ori_gate = &_gate_list[the_gate_id];
+        unsigned int reset = tokens.size() == 3 ? tokens[2] : 0;
+        new_gate = new LATCHGate(the_gate_id, lno, (*ori_gate)->get_i_list(), (*ori_gate)->get_o_list(), reset);
+
+        bool src_inverted;
+        unsigned int src_gate_id;
+        src_gate_id = literal_to_variable(tokens[1], src_inverted);
+        new_gate->add_related_gate(true, src_inverted, _gate_list[src_gate_id]);
+
+        _latch_list.push_back(the_gate_id);
+    }
     else if(type == AIG_GATE)
     {
         unsigned int the_gate_id = literal_to_variable(tokens[0]);
@@ -569,5 +632,48 @@ void CirMgr::read_init_add_gate(GateType type, unsigned int lno, const vector<in
 // about fraig
 void CirMgr::printFEC() const {}
 
-void CirMgr::printFECPairs() const {}
+void CirMgr::printFECPairs() const
+{
+    for(size_t i = 0;i < _fec_groups.size();++i)
+    {
+        cout << "[" << i << "]";
+        for(auto& lit:_fec_groups[i])
+            cout << " " << (lit % 2 ? "!" : "") << lit / 2;
+        cout << endl;
+    }
+}
+// partners are literals relative to gate "gid"
+void CirMgr::get_fec_partners(unsigned int gid, IdList& partners) const
+{
+    for(auto& group:_fec_groups)
+    {
+        for(auto& lit:group)
+        {
+            if(lit / 2 != gid)
+                continue;
+            for(auto& partner_lit:group)
+                if(partner_lit != lit)
+                    partners.push_back(partner_lit ^ (lit % 2));
+            return;
+        }
+    }
+}
+// SAT solvers used by the last CIRFraig, summed over the threads
+void CirMgr::printSatStats() const
+{
+    const SatStats& s = _fraig_sat_stats;
+    cout << endl;
+    cout << "SAT Statistics" << endl;
+    cout << "==================" << endl;
+    cout << "  Solves       " << setw(12) << right << s.solves << endl;
+    cout << "    SAT        " << setw(12) << right << s.sats << endl;
+    cout << "    UNSAT      " << setw(12) << right << s.unsats << endl;
+    cout << "    UNDEF      " << setw(12) << right << s.undefs << endl;
+    cout << "  Decisions    " << setw(12) << right << s.decisions << endl;
+    cout << "  Propagations " << setw(12) << right << s.propagations << endl;
+    cout << "  Conflicts    " << setw(12) << right << s.conflicts << endl;
+    cout << "  Learnt lits  " << setw(12) << right << s.learntLits << endl;
+    cout << "  Time (s)     " << setw(12) << right << fixed << setprecision(3) << s.time << endl;
+    cout.unsetf(ios::fixed);
+}
 void CirMgr::writeGate(ostream&, CirGate*) const {}
@@ -17,6 +17,7 @@
 using namespace std;
 
 #include "cirDef.h"
+#include "cirGate.h"
 
 extern CirMgr *cirMgr;
 
@@ -34,6 +35,12 @@ public:
 
     // for CIRRead
     bool readCircuit(const string&);
+    bool readCircuit(istream&);
+
+    // for CIREQuiv
+    // the miter of two circuits: shared PIs, one PO per pair of POs (1 when they differ)
+    bool readMiter(const string& golden_file, const string& revised_file);
+    bool proveMiter();
 
     // for CIRWrite
     void writeAag(ostream&) const;
@@ -48,20 +55,55 @@ public:
     // about optimization
     void sweep();
     void optimize();
+    // DAG-aware rewriting of 4-input cuts with the optimal AIGs of their NPN classes
+    void rewrite();
+    // rebuild the multi-input ANDs as trees of the minimum depth
+    void balance();
+    // replace gates with one divisor, or an AND/OR of two, from their windows
+    void resub();
+    // merge the latches and gates which are equivalent in every reachable state (k-step induction)
+    void sequivalence(unsigned int k, unsigned int cycle_num);
 
     // about simulation
     void randomSim();
     void fileSim(ifstream&);
+    // sequential simulation of "cycle_num" cycles from the initial state
+    void seqSim(unsigned int cycle_num);
     void setSimLog(ofstream *logFile) { _simLog = logFile; }
 
+    // about cuts
+    // gid < 0: statistics of the priority cuts; otherwise the cuts of gate "gid"
+    void printCuts(unsigned int k, unsigned int cut_limit, int gid) const;
+    // map into k-input LUTs, write the mapping as BLIF if "blif" is not NULL
+    void mapLut(unsigned int k, unsigned int cut_limit, ostream* blif) const;
+
     // about fraig
     void strash();
     void printFEC() const;
     void fraig();
+    // SAT budget for each FEC pair in fraig(), negative value means no limit
+    // pairs that run out of budget are retried with "retry_conflicts" at the end (0 means no retry)
+    void setFraigBudget(int64 conflicts, int64 propagations, int64 retry_conflicts)
+    {
+        _fraig_conflict_budget = conflicts;
+        _fraig_propagation_budget = propagations;
+        _fraig_retry_budget = retry_conflicts;
+    }
+    // FEC groups are proved by "thread_num" threads, each with its own SatSolver
+    void setFraigThreads(unsigned int thread_num) { _fraig_thread_num = thread_num; }
+    // the retried pairs are proved by a portfolio of "solver_num" solvers in parallel threads
+    void setFraigPortfolio(unsigned int solver_num) { _fraig_portfolio_num = solver_num; }
+    // queries out of the SAT budget are written to "<prefix>_<n>.cnf" in DIMACS (empty prefix: no dump)
+    void setFraigDump(const string& prefix) { _fraig_dump_prefix = prefix; }
 
     void printFECPairs() const;
+    void printSatStats() const;
+    void get_fec_partners(unsigned int gid, IdList& partners) const; // for CIRGate
     void writeGate(ostream&, CirGate*) const;
 
+    // false: no "Strashing/Simplifying/Fraig: ... merging" and simulation progress messages
+    void setVerbose(bool verbose) { _verbose = verbose; }
+
 private:
     GateList _gate_list;
     unsigned int _header_M;
@@ -72,10 +114,26 @@ private:
 
     IdList _pi_list;
     IdList _po_list;
-    //IdList _latch_list;
+    IdList _latch_list;
 
     ofstream* _simLog;
 
+    // FEC groups, each element is (variable id * 2 + inverted), sorted by variable id
+    // the inverted bit is relative to the first gate of the group
+    vector<IdList> _fec_groups;
+    bool _fec_initialized;
+
+    int64 _fraig_conflict_budget;
+    int64 _fraig_propagation_budget;
+    int64 _fraig_retry_budget;
+    unsigned int _fraig_thread_num;
+    unsigned int _fraig_portfolio_num;
+    string _fraig_dump_prefix;
+    SatStats _fraig_sat_stats; // all the solvers of the last fraig()
+    vector<pair<unsigned int, unsigned int> > _fraig_unresolved_list; // literal pairs out of budget in last fraig()
+
+    bool _verbose;
+
     // Help function for readCircuit()
     bool read_symbol_parser(string input, CirGate*& target, string& symbolic_name) const;
     bool read_interger_parser(string input, vector<int>& tokens, unsigned int number_num) const;
@@ -85,6 +143,30 @@ private:
     void read_set_gate(const vector<int>& tokens, GateType type, unsigned int lno);
     void read_init_add_gate(GateType type, unsigned int lno, const vector<int>& tokens);
 
+    // Help function for optimization
+    void get_dfs_list(IdList& dfs_list) const;
+    void merge_gate(unsigned int gid, const CirGate::RelatedGate& new_relation);
+    void get_level_list(const IdList& dfs_list, vector<unsigned int>& level_list) const;
+    unsigned int add_aig_gate(unsigned int lit_a, unsigned int lit_b);
+    unsigned int find_aig_gate(const HashMap<StrashKey, unsigned int>& strash_map, unsigned int lit_a, unsigned int lit_b) const;
+    void remove_dangling(unsigned int gid);
+
+    // Help function for simulation
+    void sim_patterns(const vector<size_t>& pi_patterns, const IdList& dfs_list);
+    void sim_write_log(size_t pattern_num) const;
+    void sim_update_fec_groups(const IdList& dfs_list);
+    void sim_signatures(const IdList& dfs_list, size_t word_num, vector<size_t>& sig_list);
+    void sim_seq_signatures(const IdList& dfs_list, unsigned int cycle_num, vector<size_t>& sig_list);
+    void sim_reset_latches();
+
+    // Help function for cuts
+    void get_cuts(CirCutMgr& cut_mgr) const;
+
+    // Help function for fraig
+    void fraig_gen_proof_model(SatSolver& solver, vector<Var>& var_list, unsigned int gid) const;
+    lbool fraig_prove(SatSolver& solver, vector<Var>& var_list, unsigned int rep_lit, unsigned int lit, int64 conflicts, int64 propagations, bool dump = false) const;
+    void fraig_merge(unsigned int rep_lit, unsigned int lit);
+
     // static function
     static inline unsigned int literal_to_variable(int literal_id, bool& inverted);
     static inline unsigned int literal_to_variable(int literal_id);
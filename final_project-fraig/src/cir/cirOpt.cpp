@@ -7,6 +7,8 @@
 ****************************************************************************/
 
 #include <cassert>
+#include <climits>
+#include <algorithm>
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "util.h"
@@ -33,6 +35,7 @@ using namespace std;
 void
 CirMgr::sweep()
 {
+    STAT_TIMER("sweep");
     bool complete = false;
     while(!complete)
     {
@@ -60,14 +63,13 @@ CirMgr::sweep()
 void
 CirMgr::optimize()
 {
+    STAT_TIMER("optimize");
     bool complete = false;
     while(!complete)
     {
         complete = true;
         IdList dfs_list;
-        CirGate::reset_visited();
-        for(auto &e:_po_list)
-            _gate_list[e]->get_dfs_list(dfs_list);
+        get_dfs_list(dfs_list);
         for(auto &e:dfs_list)
         {
             if(_gate_list[e]->get_type() != AIG_GATE)
@@ -106,17 +108,14 @@ CirMgr::optimize()
             }
 
             //cout << ia << " " << ib << " " << new_relation << endl;
-            (*ori_gate)->replace_self_in_related_gates(false, new_relation);
-            new_relation.get_gate_p()->append_related_gate_list(false, (*ori_gate)->get_o_list(), new_relation.is_inverted());
-            CirGate* new_udf_gate = new UNDEFGate(e);
-            (*ori_gate)->replace_self_in_related_gates(new_udf_gate);
-            delete (*ori_gate);
-            (*ori_gate) = new_udf_gate;
-            cout << "Simplifying: " << new_relation.get_gate_p()->get_variable_id() << " merging ";
-            if(new_relation.is_inverted())
-                cout << "!";
-            cout << e << "...\n";
-            --_header_A;
+            merge_gate(e, new_relation);
+            if(_verbose)
+            {
+                cout << "Simplifying: " << new_relation.get_gate_p()->get_variable_id() << " merging ";
+                if(new_relation.is_inverted())
+                    cout << "!";
+                cout << e << "...\n";
+            }
             complete = false;
         }
     }
@@ -125,3 +124,115 @@ CirMgr::optimize()
 /***************************************************/
 /*   Private member functions about optimization   */
 /***************************************************/
+// DFS from POs, then from the next states of the latches (a latch is a source, so the list stays
+// in topological order); visited flags are left set for the gates in the list
+void
+CirMgr::get_dfs_list(IdList& dfs_list) const
+{
+    STAT_ADD(STAT_DFS_CALLS, 1);
+    STAT_ADD(STAT_DFS_GATES, -(int64_t)dfs_list.size());
+    CirGate::reset_visited();
+    for(auto &e:_po_list)
+        _gate_list[e]->get_dfs_list(dfs_list);
+    for(auto &e:_latch_list)
+    {
+        _gate_list[e]->get_dfs_list(dfs_list);
+        _gate_list[e]->get_i_list()[0].get_gate_p()->get_dfs_list(dfs_list);
+    }
+    STAT_ADD(STAT_DFS_GATES, dfs_list.size());
+}
+
+// Replace AIG or latch gate "gid" with "new_relation" in all its output gates,
+// then replace it with an UNDEF gate
+void
+CirMgr::merge_gate(unsigned int gid, const CirGate::RelatedGate& new_relation)
+{
+    CirGate** ori_gate = &_gate_list[gid];
+    GateType type = (*ori_gate)->get_type();
+    assert(type == AIG_GATE || type == LATCH_GATE);
+    (*ori_gate)->replace_self_in_related_gates(false, new_relation);
+    new_relation.get_gate_p()->append_related_gate_list(false, (*ori_gate)->get_o_list(), new_relation.is_inverted());
+    CirGate* new_udf_gate = new UNDEFGate(gid);
+    (*ori_gate)->replace_self_in_related_gates(new_udf_gate);
+    delete (*ori_gate);
+    (*ori_gate) = new_udf_gate;
+    if(type == AIG_GATE)
+        --_header_A;
+    else
+    {
+        --_header_L;
+        _latch_list.erase(find(_latch_list.begin(), _latch_list.end(), gid));
+    }
+}
+
+// New AIG gate (lit_a & lit_b) after all the gates, return its variable id
+unsigned int
+CirMgr::add_aig_gate(unsigned int lit_a, unsigned int lit_b)
+{
+    unsigned int gid = _gate_list.size();
+    CirGate* new_gate = new AIGGate(gid, 0);
+    new_gate->add_related_gate(true, lit_a & 0x1, _gate_list[lit_a / 2]);
+    new_gate->add_related_gate(true, lit_b & 0x1, _gate_list[lit_b / 2]);
+    _gate_list.push_back(new_gate);
+    _header_M = gid; // (the ids of the POs are skipped)
+    ++_header_A;
+    return gid;
+}
+
+// Literal of (lit_a & lit_b) if it is trivial or the AIG gate is in "strash_map", UINT_MAX otherwise;
+// the entries of removed or changed gates are ignored
+unsigned int
+CirMgr::find_aig_gate(const HashMap<StrashKey, unsigned int>& strash_map, unsigned int lit_a, unsigned int lit_b) const
+{
+    if(lit_a == lit_b || lit_b == 1)
+        return lit_a;
+    if(lit_a == 1)
+        return lit_b;
+    if(lit_a == 0 || lit_b == 0 || (lit_a ^ lit_b) == 1)
+        return 0;
+    unsigned int gid;
+    STAT_ADD(STAT_STRASH_PROBES, 1);
+    if(!strash_map.query(StrashKey(lit_a, lit_b), gid))
+        return UINT_MAX;
+    if(_gate_list[gid]->get_type() != AIG_GATE || !(StrashKey(_gate_list[gid]) == StrashKey(lit_a, lit_b)))
+        return UINT_MAX;
+    return gid * 2;
+}
+
+// Remove AIG gate "gid" if it has no fanout, then its inputs in the same way
+void
+CirMgr::remove_dangling(unsigned int gid)
+{
+    IdList stack(1, gid);
+    while(!stack.empty())
+    {
+        unsigned int g = stack.back();
+        stack.pop_back();
+        if(!_gate_list[g]->is_not_using() || _gate_list[g]->get_type() != AIG_GATE)
+            continue;
+        for(auto& input:_gate_list[g]->get_i_list())
+            stack.push_back(input.get_gate_p()->get_variable_id());
+        CirGate* new_gate = new UNDEFGate(g);
+        _gate_list[g]->replace_self_in_related_gates(new_gate);
+        delete _gate_list[g];
+        _gate_list[g] = new_gate;
+        --_header_A;
+    }
+}
+
+// Level of every gate in dfs_list, PI/CONST/UNDEF are level 0 and an AIG gate is
+// one more than its highest input; dfs_list is in topological order already
+void
+CirMgr::get_level_list(const IdList& dfs_list, vector<unsigned int>& level_list) const
+{
+    level_list.assign(_gate_list.size(), 0);
+    for(auto& e:dfs_list)
+    {
+        const CirGate* gate = _gate_list[e];
+        if(gate->get_type() != AIG_GATE)
+            continue;
+        for(auto& input:gate->get_i_list())
+            if(level_list[input.get_gate_p()->get_variable_id()] + 1 > level_list[e])
+                level_list[e] = level_list[input.get_gate_p()->get_variable_id()] + 1;
+    }
+}
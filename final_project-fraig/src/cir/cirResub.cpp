@@ -0,0 +1,252 @@
+/****************************************************************************
+  FileName     [ cirResub.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir resubstitution functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "sat.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const size_t RESUB_WORD_NUM = 4;          // 64-bit words of random patterns in a signature
+static const unsigned int RESUB_WINDOW_DEPTH = 5; // levels of the fanin cone in a window
+static const size_t RESUB_WINDOW_SIZE = 64;      // gates in a window
+static const size_t RESUB_TRY_LIMIT = 4;         // SAT queries per gate
+static const int64 RESUB_CONFLICT_BUDGET = 1000;
+
+// the gate is (lit_a ^ out_inv), or ((lit_a & lit_b) ^ out_inv) if lit_b is not UINT_MAX
+struct ResubCandidate
+{
+    ResubCandidate(unsigned int a, unsigned int b, bool inv): lit_a(a), lit_b(b), out_inv(inv) {}
+    unsigned int lit_a;
+    unsigned int lit_b;
+    bool out_inv;
+};
+
+/*****************************************************/
+/*   Public member functions about resubstitution   */
+/*****************************************************/
+// For every AIG gate in dfs order, the window is its fanin cone up to RESUB_WINDOW_DEPTH levels
+// and the divisors are the gates of the window outside its MFFC (maximum fanout-free cone, only
+// counted in the window).
+// A divisor literal d with the same signature (random simulation values) replaces the gate and
+// saves the MFFC; an AND of two divisor literals (or its inverse, an OR) costs one new gate.
+// Candidates are proved by SAT on the window only, with its leaves as free variables, so a proof
+// holds for any value of the leaves.
+void
+CirMgr::resub()
+{
+    STAT_TIMER("resub");
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    vector<size_t> sig_list;
+    sim_signatures(dfs_list, RESUB_WORD_NUM, sig_list);
+    auto sig = [&](unsigned int lit, size_t i) // signature of a literal
+    { return (lit & 0x1) ? ~sig_list[lit / 2 * RESUB_WORD_NUM + i] : sig_list[lit / 2 * RESUB_WORD_NUM + i]; };
+
+    SatSolver solver;
+    vector<Var> var_list(_gate_list.size(), var_Undef);
+    // SAT on (lit xor (va ^ fa)), l_False means they are equivalent
+    auto prove = [&](unsigned int lit, Var va, bool fa)
+    {
+        fraig_gen_proof_model(solver, var_list, lit / 2);
+        Var miter = solver.newGroup();
+        solver.addGroupXorCNF(miter, var_list[lit / 2], lit & 0x1, va, fa);
+        solver.assumeRelease();
+        solver.enableGroup(miter);
+        lbool result = solver.assumpSolveLimited(RESUB_CONFLICT_BUDGET);
+        solver.releaseGroup(miter);
+        return result;
+    };
+
+    vector<unsigned int> deref;
+    vector<bool> in_mffc;
+    IdList window, mffc, divisors, covers;
+    vector<unsigned int> distance;
+    size_t ori_aig_num = _header_A, divisor_num = 0, and_num = 0, query_num = 0;
+    for(auto& e:dfs_list)
+    {
+        if(_gate_list[e]->get_type() != AIG_GATE)
+            continue;
+        deref.resize(_gate_list.size(), 0);
+        in_mffc.resize(_gate_list.size(), false);
+        distance.resize(_gate_list.size(), 0);
+
+        // window: the gates with their distances from the gate, breadth first
+        CirGate::reset_visited();
+        window.assign(1, e);
+        _gate_list[e]->set_visited();
+        distance[e] = 0;
+        for(size_t i = 0;i < window.size();++i)
+        {
+            const CirGate* gate = _gate_list[window[i]];
+            if(gate->get_type() != AIG_GATE || distance[window[i]] == RESUB_WINDOW_DEPTH)
+                continue;
+            for(auto& input:gate->get_i_list())
+            {
+                unsigned int g = input.get_gate_p()->get_variable_id();
+                if(_gate_list[g]->is_visited() || window.size() == RESUB_WINDOW_SIZE)
+                    continue;
+                _gate_list[g]->set_visited();
+                distance[g] = distance[window[i]] + 1;
+                window.push_back(g);
+            }
+        }
+        // a gate with an input out of the window is a leaf
+        auto is_leaf = [&](unsigned int g)
+        {
+            const CirGate* gate = _gate_list[g];
+            if(gate->get_type() != AIG_GATE)
+                return true;
+            for(auto& input:gate->get_i_list())
+                if(!input.get_gate_p()->is_visited())
+                    return true;
+            return false;
+        };
+        // MFFC in the window
+        mffc.assign(1, e);
+        in_mffc[e] = true;
+        for(size_t i = 0;i < mffc.size();++i)
+        {
+            for(auto& input:_gate_list[mffc[i]]->get_i_list())
+            {
+                unsigned int g = input.get_gate_p()->get_variable_id();
+                if(_gate_list[g]->get_type() != AIG_GATE || !_gate_list[g]->is_visited())
+                    continue;
+                if(++deref[g] == _gate_list[g]->get_o_list().size())
+                {
+                    in_mffc[g] = true;
+                    mffc.push_back(g);
+                }
+            }
+        }
+        for(auto& g:mffc)
+            for(auto& input:_gate_list[g]->get_i_list())
+                deref[input.get_gate_p()->get_variable_id()] = 0;
+
+        divisors.clear();
+        divisors.push_back(0); // CONST 0
+        for(auto& g:window)
+            if(!in_mffc[g] && g != 0)
+                divisors.push_back(g);
+        for(auto& g:mffc)
+            in_mffc[g] = false;
+
+        // candidates: 0-resubstitution (a divisor literal) first, then 1-resubstitution (an AND of two)
+        vector<ResubCandidate> candidates;
+        unsigned int gate_lit = e * 2;
+        for(auto& d:divisors)
+        {
+            for(unsigned int lit = d * 2;lit <= d * 2 + 1 && candidates.size() < RESUB_TRY_LIMIT;++lit)
+            {
+                bool equal = true;
+                for(size_t i = 0;i < RESUB_WORD_NUM && equal;++i)
+                    equal = sig(lit, i) == sig(gate_lit, i);
+                if(equal)
+                    candidates.push_back(ResubCandidate(lit, UINT_MAX, false));
+            }
+        }
+        for(unsigned int out_inv = 0;out_inv < 2 && mffc.size() > 1;++out_inv)
+        {
+            // the literals which are 1 whenever the target is, then the pairs of them
+            unsigned int target = gate_lit ^ out_inv;
+            covers.clear();
+            for(size_t j = 1;j < divisors.size();++j)
+            {
+                for(unsigned int lit = divisors[j] * 2;lit <= divisors[j] * 2 + 1;++lit)
+                {
+                    bool cover = true;
+                    for(size_t i = 0;i < RESUB_WORD_NUM && cover;++i)
+                        cover = (sig(target, i) & ~sig(lit, i)) == 0;
+                    if(cover)
+                        covers.push_back(lit);
+                }
+            }
+            for(size_t a = 0;a < covers.size() && candidates.size() < RESUB_TRY_LIMIT;++a)
+            {
+                for(size_t b = a + 1;b < covers.size() && candidates.size() < RESUB_TRY_LIMIT;++b)
+                {
+                    bool equal = true;
+                    for(size_t i = 0;i < RESUB_WORD_NUM && equal;++i)
+                        equal = (sig(covers[a], i) & sig(covers[b], i)) == sig(target, i);
+                    if(equal)
+                        candidates.push_back(ResubCandidate(covers[a], covers[b], out_inv));
+                }
+            }
+        }
+        if(candidates.empty())
+            continue;
+
+        // prove the candidates on the window
+        solver.initialize();
+        var_list.resize(_gate_list.size(), var_Undef);
+        var_list[0] = solver.newVar();
+        solver.assertProperty(var_list[0], false);
+        for(auto& g:window)
+            if(g != 0 && is_leaf(g))
+                var_list[g] = solver.newVar();
+        const ResubCandidate* found = 0;
+        for(auto& c:candidates)
+        {
+            ++query_num;
+            fraig_gen_proof_model(solver, var_list, c.lit_a / 2);
+            Var v = var_list[c.lit_a / 2];
+            bool inv = c.lit_a & 0x1;
+            if(c.lit_b != UINT_MAX)
+            {
+                fraig_gen_proof_model(solver, var_list, c.lit_b / 2);
+                v = solver.newVar();
+                solver.addAigCNF(v, var_list[c.lit_a / 2], c.lit_a & 0x1, var_list[c.lit_b / 2], c.lit_b & 0x1);
+                inv = false;
+            }
+            if(prove(gate_lit, v, inv ^ c.out_inv) == l_False)
+            {
+                found = &c;
+                break;
+            }
+        }
+        for(auto& g:window)
+            var_list[g] = var_Undef;
+        if(!found)
+            continue;
+
+        // replace the gate
+        IdList inputs;
+        for(auto& input:_gate_list[e]->get_i_list())
+            inputs.push_back(input.get_gate_p()->get_variable_id());
+        if(found->lit_b == UINT_MAX)
+        {
+            merge_gate(e, CirGate::RelatedGate(_gate_list[found->lit_a / 2], found->lit_a & 0x1));
+            ++divisor_num;
+        }
+        else
+        {
+            unsigned int gid = add_aig_gate(found->lit_a, found->lit_b);
+            for(size_t i = 0;i < RESUB_WORD_NUM;++i)
+                sig_list.push_back(sig(found->lit_a, i) & sig(found->lit_b, i));
+            merge_gate(e, CirGate::RelatedGate(_gate_list[gid], found->out_inv));
+            ++and_num;
+        }
+        for(auto& g:inputs)
+            remove_dangling(g);
+    }
+    if(_verbose)
+        cout << "Resubstitution: " << divisor_num << " gate(s) by a divisor, " << and_num << " by an AND/OR of two, "
+             << query_num << " SAT queries, AIG " << ori_aig_num << " -> " << _header_A << endl;
+}
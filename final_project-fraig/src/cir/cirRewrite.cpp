@@ -0,0 +1,543 @@
+/****************************************************************************
+  FileName     [ cirRewrite.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir DAG-aware rewriting functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirCut.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const unsigned int REWRITE_CUT_LIMIT = 8;    // 4-input cuts per gate
+static const unsigned int REWRITE_CONE_LIMIT = 64;  // cuts with larger cones are skipped
+static const unsigned int NPN_CLASS_NUM = 222;
+static const unsigned int NPN_MAX_GATE_NUM = 14;
+
+// An AIG with the fewest AND gates for the representative (the smallest truth table) of each
+// 4-input NPN class, in increasing order of the representatives.
+// Literal 2 * v + inverted: v = 0 is CONST 0, v = 1..4 the inputs, v = 5.. the gates in order.
+// Generated by exact synthesis with the SAT solver (src/sat/test/npnSyn, 100000 conflicts per
+// query); the classes marked "not proven optimal" ran out of the budget, their AIGs are the
+// smallest ones found.
+struct NpnStructure
+{
+    unsigned int truth;
+    unsigned int gate_num;
+    unsigned int output;
+    unsigned int fanins[2 * NPN_MAX_GATE_NUM];
+};
+static const NpnStructure NPN_LIBRARY[NPN_CLASS_NUM] =
+{
+    { 0x0000, 0,  0, {} },
+    { 0x0001, 3, 14, { 7, 9, 5, 10, 3, 12 } },
+    { 0x0003, 2, 12, { 7, 9, 5, 10 } },
+    { 0x0006, 5, 18, { 3, 4, 2, 5, 11, 13, 9, 15, 7, 16 } },
+    { 0x0007, 3, 14, { 2, 4, 7, 11, 9, 12 } },
+    { 0x000f, 1, 10, { 7, 9 } },
+    { 0x0016, 7, 22, { 4, 6, 5, 7, 2, 13, 3, 12, 9, 15, 17, 18, 11, 20 } },
+    { 0x0017, 5, 18, { 3, 7, 2, 6, 5, 13, 11, 15, 9, 17 } },
+    { 0x0018, 6, 20, { 4, 7, 5, 6, 3, 12, 2, 10, 15, 17, 9, 19 } },
+    { 0x0019, 5, 18, { 4, 7, 3, 5, 2, 10, 13, 15, 9, 17 } },
+    { 0x001b, 4, 16, { 3, 5, 2, 7, 11, 13, 9, 15 } },
+    { 0x001e, 5, 18, { 3, 5, 7, 11, 6, 10, 13, 15, 9, 17 } },
+    { 0x001f, 3, 14, { 3, 5, 6, 11, 9, 13 } },
+    { 0x003c, 4, 16, { 5, 6, 4, 7, 11, 13, 9, 15 } },
+    { 0x003d, 5, 18, { 2, 7, 4, 7, 5, 11, 13, 15, 9, 17 } },
+    { 0x003f, 2, 12, { 4, 6, 9, 11 } },
+    { 0x0069, 7, 22, { 5, 6, 4, 7, 11, 13, 3, 14, 2, 15, 17, 19, 9, 21 } },
+    { 0x006b, 7, 22, { 4, 6, 5, 7, 2, 10, 3, 13, 11, 16, 15, 19, 9, 20 } },
+    { 0x006f, 5, 18, { 3, 4, 2, 5, 6, 13, 11, 14, 9, 17 } },
+    { 0x007e, 6, 20, { 3, 5, 2, 6, 5, 6, 11, 13, 15, 17, 9, 19 } },
+    { 0x007f, 3, 14, { 4, 6, 2, 10, 9, 13 } },
+    { 0x00ff, 0,  9, {} },
+    { 0x0116, 9, 26, { 2, 6, 3, 7, 5, 9, 4, 8, 12, 15, 13, 14, 11, 17, 19, 21, 22, 25 } }, // (not proven optimal)
+    { 0x0117, 7, 23, { 4, 6, 5, 7, 9, 11, 2, 15, 3, 14, 12, 17, 19, 21 } },
+    { 0x0118, 8, 24, { 3, 4, 6, 8, 7, 9, 2, 15, 13, 15, 5, 19, 17, 21, 11, 22 } }, // (not proven optimal)
+    { 0x0119, 7, 22, { 2, 5, 2, 9, 4, 13, 9, 13, 11, 15, 6, 17, 18, 21 } },
+    { 0x011a, 7, 23, { 7, 9, 6, 8, 2, 10, 11, 13, 3, 16, 5, 18, 15, 21 } },
+    { 0x011b, 6, 20, { 3, 4, 3, 7, 2, 6, 8, 13, 15, 17, 11, 18 } },
+    { 0x011e, 7, 22, { 3, 5, 6, 8, 7, 9, 10, 13, 10, 14, 15, 17, 19, 21 } },
+    { 0x011f, 5, 19, { 3, 5, 6, 8, 7, 9, 10, 13, 15, 17 } },
+    { 0x012c, 8, 24, { 3, 6, 2, 8, 7, 9, 5, 14, 4, 15, 13, 17, 19, 20, 11, 22 } }, // (not proven optimal)
+    { 0x012d, 7, 22, { 2, 5, 7, 11, 6, 10, 5, 15, 13, 15, 8, 17, 19, 21 } },
+    { 0x012f, 5, 18, { 3, 5, 5, 11, 8, 11, 6, 13, 15, 17 } },
+    { 0x013c, 7, 22, { 5, 7, 4, 6, 3, 8, 8, 11, 11, 13, 15, 19, 17, 21 } },
+    { 0x013d, 6, 20, { 5, 7, 4, 6, 2, 10, 8, 11, 13, 17, 15, 18 } },
+    { 0x013e, 7, 22, { 4, 6, 5, 7, 3, 12, 8, 14, 9, 15, 17, 19, 11, 21 } },
+    { 0x013f, 5, 19, { 3, 7, 7, 9, 8, 11, 5, 15, 13, 17 } },
+    { 0x0168, 11, 31, { 3, 7, 2, 6, 8, 11, 5, 13, 5, 15, 8, 18, 12, 19, 17, 23, 11, 24, 9, 26, 21, 29 } }, // (not proven optimal)
+    { 0x0169, 8, 25, { 3, 6, 6, 9, 2, 13, 11, 15, 4, 17, 5, 16, 9, 18, 21, 23 } }, // (not proven optimal)
+    { 0x016a, 10, 29, { 4, 7, 4, 11, 9, 13, 5, 7, 9, 12, 8, 16, 19, 21, 3, 23, 2, 14, 25, 27 } }, // (not proven optimal)
+    { 0x016b, 9, 27, { 5, 7, 4, 6, 2, 12, 4, 12, 3, 17, 9, 19, 10, 18, 15, 20, 23, 25 } }, // (not proven optimal)
+    { 0x016e, 8, 25, { 3, 4, 4, 6, 2, 13, 11, 15, 9, 17, 8, 16, 7, 20, 19, 23 } }, // (not proven optimal)
+    { 0x016f, 6, 20, { 3, 5, 2, 4, 8, 11, 11, 13, 6, 17, 15, 19 } },
+    { 0x017e, 10, 29, { 4, 7, 4, 11, 9, 13, 5, 7, 9, 17, 8, 16, 19, 21, 3, 23, 2, 14, 25, 27 } }, // (not proven optimal)
+    { 0x017f, 6, 20, { 3, 7, 2, 6, 8, 11, 9, 13, 4, 17, 15, 19 } },
+    { 0x0180, 7, 23, { 6, 9, 4, 10, 7, 8, 5, 14, 3, 16, 2, 12, 19, 21 } },
+    { 0x0181, 6, 21, { 6, 9, 4, 10, 5, 7, 3, 14, 2, 12, 17, 19 } },
+    { 0x0182, 8, 25, { 5, 7, 4, 6, 11, 13, 9, 15, 8, 10, 3, 18, 2, 16, 21, 23 } }, // (not proven optimal)
+    { 0x0183, 6, 20, { 2, 4, 4, 7, 2, 8, 6, 11, 13, 15, 17, 18 } },
+    { 0x0186, 9, 26, { 5, 6, 4, 8, 5, 9, 7, 15, 3, 16, 11, 17, 2, 20, 19, 23, 13, 25 } }, // (not proven optimal)
+    { 0x0187, 7, 22, { 2, 4, 3, 5, 7, 10, 6, 11, 8, 13, 15, 19, 17, 20 } },
+    { 0x0189, 5, 19, { 4, 9, 5, 7, 3, 12, 2, 10, 15, 17 } },
+    { 0x018b, 5, 18, { 3, 4, 5, 6, 2, 8, 13, 15, 11, 16 } },
+    { 0x018f, 5, 18, { 2, 4, 3, 5, 6, 11, 8, 13, 15, 17 } },
+    { 0x0196, 10, 29, { 5, 7, 4, 6, 11, 13, 9, 15, 9, 14, 8, 10, 19, 21, 3, 23, 2, 16, 25, 27 } }, // (not proven optimal)
+    { 0x0197, 10, 28, { 3, 7, 2, 6, 5, 10, 8, 15, 13, 17, 5, 18, 4, 19, 11, 21, 23, 24, 17, 27 } }, // (not proven optimal)
+    { 0x0198, 8, 25, { 4, 9, 7, 8, 6, 9, 13, 15, 5, 17, 3, 18, 2, 10, 21, 23 } }, // (not proven optimal)
+    { 0x0199, 6, 20, { 3, 4, 2, 5, 3, 7, 11, 13, 8, 15, 16, 19 } },
+    { 0x019a, 8, 24, { 3, 5, 5, 6, 9, 13, 8, 12, 3, 14, 11, 15, 19, 21, 17, 22 } }, // (not proven optimal)
+    { 0x019b, 7, 22, { 3, 4, 2, 5, 2, 8, 9, 13, 7, 15, 17, 19, 11, 21 } },
+    { 0x019e, 10, 29, { 3, 5, 2, 4, 11, 13, 9, 15, 9, 11, 8, 10, 19, 21, 7, 23, 6, 16, 25, 27 } }, // (not proven optimal)
+    { 0x019f, 7, 22, { 3, 5, 2, 4, 8, 11, 9, 10, 6, 13, 17, 18, 15, 21 } },
+    { 0x01a8, 6, 21, { 5, 7, 3, 10, 2, 11, 9, 14, 8, 12, 17, 19 } },
+    { 0x01a9, 5, 19, { 5, 7, 3, 10, 2, 11, 9, 14, 13, 17 } },
+    { 0x01aa, 5, 19, { 7, 8, 5, 10, 3, 12, 2, 9, 15, 17 } },
+    { 0x01ab, 4, 17, { 5, 7, 3, 10, 2, 9, 13, 15 } },
+    { 0x01ac, 7, 22, { 3, 6, 5, 7, 9, 13, 8, 12, 3, 16, 15, 19, 11, 21 } },
+    { 0x01ad, 6, 20, { 3, 6, 5, 7, 2, 12, 8, 13, 11, 17, 15, 18 } },
+    { 0x01ae, 6, 20, { 3, 5, 3, 6, 9, 10, 8, 11, 15, 17, 13, 18 } },
+    { 0x01af, 4, 16, { 3, 5, 3, 6, 8, 11, 13, 15 } },
+    { 0x01bc, 8, 24, { 3, 5, 5, 9, 8, 11, 6, 13, 7, 12, 3, 16, 15, 19, 21, 22 } }, // (not proven optimal)
+    { 0x01bd, 7, 22, { 3, 4, 3, 7, 5, 7, 8, 15, 11, 15, 13, 19, 17, 21 } },
+    { 0x01be, 8, 24, { 3, 4, 5, 7, 6, 10, 3, 12, 8, 17, 9, 16, 15, 19, 21, 22 } }, // (not proven optimal)
+    { 0x01bf, 6, 21, { 5, 6, 3, 11, 5, 12, 6, 12, 9, 17, 15, 19 } },
+    { 0x01e8, 8, 24, { 5, 7, 4, 6, 3, 10, 9, 10, 3, 13, 9, 19, 15, 21, 17, 23 } }, // (not proven optimal)
+    { 0x01e9, 7, 22, { 2, 6, 3, 7, 5, 11, 4, 12, 9, 15, 13, 19, 17, 21 } },
+    { 0x01ea, 7, 23, { 4, 6, 3, 11, 8, 12, 9, 13, 5, 14, 7, 18, 17, 21 } },
+    { 0x01eb, 6, 20, { 5, 7, 4, 6, 3, 13, 8, 15, 11, 14, 17, 19 } },
+    { 0x01ee, 5, 19, { 3, 5, 7, 10, 9, 11, 8, 12, 15, 17 } },
+    { 0x01ef, 4, 17, { 3, 5, 7, 10, 9, 11, 13, 15 } },
+    { 0x01fe, 5, 19, { 5, 7, 3, 10, 9, 13, 8, 12, 15, 17 } },
+    { 0x033c, 6, 20, { 6, 8, 7, 9, 4, 12, 5, 13, 15, 17, 11, 19 } },
+    { 0x033d, 7, 23, { 2, 5, 6, 8, 7, 9, 5, 13, 11, 14, 15, 16, 19, 21 } },
+    { 0x033f, 4, 16, { 6, 8, 7, 9, 4, 13, 11, 15 } },
+    { 0x0356, 5, 18, { 5, 7, 3, 9, 10, 12, 11, 13, 15, 17 } },
+    { 0x0357, 3, 15, { 5, 7, 3, 9, 11, 13 } },
+    { 0x0358, 7, 22, { 5, 7, 3, 9, 7, 9, 11, 13, 14, 17, 15, 16, 19, 21 } },
+    { 0x0359, 7, 22, { 4, 7, 2, 9, 6, 8, 13, 15, 11, 17, 10, 16, 19, 21 } },
+    { 0x035a, 6, 20, { 3, 9, 4, 8, 7, 10, 6, 11, 13, 15, 17, 18 } },
+    { 0x035b, 6, 21, { 3, 9, 6, 10, 9, 11, 4, 15, 7, 17, 13, 19 } },
+    { 0x035e, 7, 23, { 3, 9, 5, 11, 4, 9, 13, 15, 7, 17, 6, 10, 19, 21 } },
+    { 0x035f, 4, 16, { 3, 9, 4, 8, 6, 11, 13, 15 } },
+    { 0x0368, 10, 29, { 2, 6, 3, 7, 6, 8, 5, 15, 9, 15, 11, 18, 13, 20, 16, 21, 17, 22, 25, 27 } }, // (not proven optimal)
+    { 0x0369, 8, 24, { 2, 9, 6, 11, 7, 10, 13, 15, 5, 17, 9, 17, 4, 21, 19, 23 } }, // (not proven optimal)
+    { 0x036a, 9, 27, { 5, 7, 4, 7, 4, 13, 3, 14, 2, 15, 17, 19, 9, 21, 8, 10, 23, 25 } }, // (not proven optimal)
+    { 0x036b, 7, 23, { 5, 7, 4, 6, 2, 13, 3, 12, 15, 17, 9, 19, 11, 21 } },
+    { 0x036c, 8, 25, { 2, 6, 6, 8, 9, 11, 4, 15, 4, 17, 15, 17, 13, 20, 19, 23 } }, // (not proven optimal)
+    { 0x036d, 11, 31, { 3, 9, 7, 9, 6, 10, 13, 15, 2, 9, 7, 19, 6, 18, 21, 23, 5, 25, 4, 17, 27, 29 } }, // (not proven optimal)
+    { 0x036e, 8, 24, { 3, 4, 4, 6, 5, 7, 2, 13, 8, 15, 9, 17, 11, 20, 19, 23 } }, // (not proven optimal)
+    { 0x036f, 7, 23, { 3, 4, 2, 5, 4, 8, 6, 11, 9, 12, 15, 17, 19, 21 } },
+    { 0x037c, 7, 23, { 5, 7, 4, 6, 8, 10, 2, 12, 11, 17, 9, 18, 15, 21 } },
+    { 0x037d, 7, 22, { 5, 7, 4, 6, 8, 11, 9, 10, 13, 17, 2, 19, 15, 21 } },
+    { 0x037e, 9, 27, { 5, 7, 4, 7, 4, 13, 3, 11, 2, 15, 17, 19, 9, 21, 8, 10, 23, 25 } }, // (not proven optimal)
+    { 0x03c0, 5, 19, { 6, 9, 7, 8, 5, 12, 4, 10, 15, 17 } },
+    { 0x03c1, 6, 21, { 5, 7, 4, 6, 2, 9, 9, 12, 10, 15, 17, 19 } },
+    { 0x03c3, 4, 17, { 6, 9, 5, 7, 4, 10, 13, 15 } },
+    { 0x03c5, 6, 20, { 5, 6, 4, 8, 7, 9, 11, 13, 2, 14, 16, 19 } },
+    { 0x03c6, 6, 20, { 3, 9, 7, 11, 5, 13, 9, 13, 4, 17, 15, 19 } },
+    { 0x03c7, 5, 19, { 2, 7, 5, 7, 4, 9, 11, 14, 13, 17 } },
+    { 0x03cf, 3, 15, { 5, 7, 4, 9, 11, 13 } },
+    { 0x03d4, 7, 22, { 5, 7, 4, 6, 3, 11, 8, 11, 9, 13, 15, 18, 17, 21 } },
+    { 0x03d5, 6, 20, { 5, 7, 4, 6, 8, 11, 9, 13, 2, 16, 15, 19 } },
+    { 0x03d6, 8, 24, { 4, 6, 5, 7, 6, 10, 2, 15, 9, 17, 12, 18, 13, 19, 21, 23 } }, // (not proven optimal)
+    { 0x03d7, 5, 19, { 5, 7, 4, 6, 2, 13, 9, 15, 11, 17 } },
+    { 0x03d8, 7, 23, { 5, 7, 3, 6, 2, 4, 13, 15, 9, 17, 8, 10, 19, 21 } },
+    { 0x03d9, 7, 23, { 2, 9, 5, 10, 7, 11, 9, 13, 5, 14, 15, 16, 19, 21 } },
+    { 0x03db, 6, 21, { 2, 4, 3, 6, 5, 7, 11, 13, 9, 17, 15, 19 } },
+    { 0x03dc, 6, 21, { 2, 5, 5, 7, 9, 13, 8, 12, 11, 14, 17, 19 } },
+    { 0x03dd, 5, 18, { 5, 7, 2, 9, 8, 11, 5, 12, 15, 17 } },
+    { 0x03de, 6, 20, { 2, 5, 5, 7, 9, 11, 13, 15, 12, 14, 17, 19 } },
+    { 0x03fc, 4, 17, { 5, 7, 9, 11, 8, 10, 13, 15 } },
+    { 0x0660, 7, 22, { 3, 5, 2, 4, 7, 9, 6, 8, 13, 15, 17, 18, 11, 20 } },
+    { 0x0661, 10, 28, { 3, 5, 2, 4, 6, 10, 9, 13, 11, 13, 15, 16, 7, 18, 9, 22, 21, 23, 25, 27 } }, // (not proven optimal)
+    { 0x0662, 7, 22, { 2, 5, 7, 9, 6, 8, 3, 13, 4, 16, 11, 19, 15, 21 } },
+    { 0x0663, 7, 22, { 6, 8, 7, 9, 3, 13, 5, 14, 4, 15, 11, 19, 17, 20 } },
+    { 0x0666, 5, 18, { 3, 5, 2, 4, 6, 8, 11, 13, 15, 16 } },
+    { 0x0667, 7, 22, { 2, 4, 3, 5, 7, 9, 6, 8, 12, 15, 11, 17, 19, 20 } },
+    { 0x0669, 10, 29, { 3, 4, 2, 5, 11, 13, 9, 15, 9, 14, 8, 15, 19, 21, 7, 23, 6, 16, 25, 27 } }, // (not proven optimal)
+    { 0x066b, 11, 30, { 6, 8, 7, 9, 2, 12, 3, 13, 4, 17, 4, 19, 17, 18, 16, 21, 23, 25, 15, 27, 11, 29 } }, // (not proven optimal)
+    { 0x066f, 7, 23, { 3, 4, 2, 5, 11, 13, 8, 14, 9, 15, 7, 17, 19, 21 } },
+    { 0x0672, 7, 22, { 2, 4, 4, 8, 6, 8, 7, 13, 3, 16, 15, 19, 11, 20 } },
+    { 0x0673, 8, 24, { 3, 8, 6, 8, 5, 10, 7, 11, 3, 17, 4, 19, 15, 21, 13, 22 } }, // (not proven optimal)
+    { 0x0676, 6, 20, { 3, 5, 2, 4, 6, 9, 7, 11, 15, 17, 13, 19 } },
+    { 0x0678, 11, 31, { 2, 5, 2, 11, 9, 13, 3, 4, 11, 17, 9, 12, 8, 19, 21, 23, 7, 25, 6, 14, 27, 29 } }, // (not proven optimal)
+    { 0x0679, 11, 31, { 2, 5, 2, 11, 9, 13, 3, 4, 11, 17, 9, 18, 8, 19, 21, 23, 7, 25, 6, 14, 27, 29 } }, // (not proven optimal)
+    { 0x067a, 10, 28, { 5, 6, 4, 8, 4, 8, 6, 8, 2, 11, 7, 13, 18, 21, 19, 20, 17, 23, 25, 26 } }, // (not proven optimal)
+    { 0x067b, 9, 27, { 4, 8, 5, 9, 6, 8, 7, 11, 3, 17, 2, 16, 15, 18, 21, 23, 13, 24 } }, // (not proven optimal)
+    { 0x067e, 10, 29, { 2, 4, 3, 5, 8, 10, 7, 13, 7, 15, 15, 16, 11, 21, 6, 22, 9, 24, 21, 27 } }, // (not proven optimal)
+    { 0x0690, 8, 25, { 3, 5, 2, 4, 11, 13, 9, 15, 8, 14, 7, 18, 6, 16, 21, 23 } }, // (not proven optimal)
+    { 0x0691, 10, 29, { 3, 5, 2, 4, 11, 13, 9, 15, 9, 10, 8, 14, 19, 21, 7, 23, 6, 16, 25, 27 } }, // (not proven optimal)
+    { 0x0693, 10, 29, { 3, 5, 2, 4, 11, 13, 9, 15, 5, 9, 8, 14, 19, 21, 7, 23, 6, 16, 25, 27 } }, // (not proven optimal)
+    { 0x0696, 7, 23, { 3, 5, 2, 4, 11, 13, 9, 15, 7, 14, 6, 16, 19, 21 } },
+    { 0x0697, 8, 25, { 3, 5, 2, 4, 7, 11, 13, 14, 12, 15, 11, 19, 9, 21, 17, 23 } }, // (not proven optimal)
+    { 0x069f, 6, 20, { 2, 4, 3, 5, 11, 13, 6, 14, 8, 15, 17, 19 } },
+    { 0x06b0, 10, 29, { 3, 5, 3, 11, 9, 13, 3, 4, 2, 5, 17, 19, 8, 21, 7, 22, 6, 14, 25, 27 } }, // (not proven optimal)
+    { 0x06b1, 10, 28, { 2, 6, 4, 7, 2, 11, 9, 14, 8, 15, 11, 19, 13, 18, 4, 20, 23, 25, 17, 26 } }, // (not proven optimal)
+    { 0x06b2, 8, 24, { 3, 4, 2, 5, 6, 8, 9, 10, 7, 13, 15, 17, 11, 18, 20, 23 } }, // (not proven optimal)
+    { 0x06b3, 8, 24, { 2, 6, 3, 8, 6, 8, 5, 12, 11, 13, 15, 17, 4, 18, 20, 23 } }, // (not proven optimal)
+    { 0x06b4, 9, 26, { 3, 4, 5, 8, 9, 11, 2, 12, 6, 15, 11, 17, 6, 18, 7, 20, 23, 25 } }, // (not proven optimal)
+    { 0x06b5, 10, 28, { 3, 4, 2, 7, 9, 11, 5, 15, 6, 15, 12, 17, 13, 16, 21, 23, 19, 24, 24, 26 } }, // (not proven optimal)
+    { 0x06b6, 7, 23, { 3, 4, 2, 5, 6, 9, 11, 13, 11, 14, 7, 17, 19, 21 } },
+    { 0x06b7, 8, 25, { 4, 7, 5, 9, 6, 8, 3, 10, 2, 15, 13, 17, 11, 18, 20, 23 } }, // (not proven optimal)
+    { 0x06b9, 9, 26, { 4, 9, 5, 8, 6, 9, 11, 13, 2, 16, 3, 17, 7, 19, 15, 23, 21, 25 } }, // (not proven optimal)
+    { 0x06bd, 10, 29, { 3, 4, 3, 5, 2, 4, 9, 11, 7, 13, 15, 18, 16, 20, 16, 23, 20, 23, 25, 27 } }, // (not proven optimal)
+    { 0x06f0, 7, 23, { 3, 4, 2, 5, 11, 13, 8, 15, 7, 16, 6, 9, 19, 21 } },
+    { 0x06f1, 7, 23, { 3, 5, 2, 4, 7, 11, 9, 15, 13, 14, 8, 18, 17, 21 } },
+    { 0x06f2, 7, 23, { 4, 8, 3, 10, 2, 5, 13, 15, 7, 17, 6, 9, 19, 21 } },
+    { 0x06f6, 6, 21, { 3, 4, 2, 5, 11, 13, 7, 15, 6, 9, 17, 19 } },
+    { 0x06f9, 7, 23, { 3, 4, 2, 5, 11, 13, 7, 15, 9, 17, 8, 16, 19, 21 } },
+    { 0x0776, 7, 22, { 3, 4, 7, 9, 6, 8, 3, 12, 5, 17, 11, 19, 15, 21 } },
+    { 0x0778, 7, 22, { 2, 4, 6, 8, 7, 9, 11, 15, 10, 14, 17, 19, 13, 21 } },
+    { 0x0779, 9, 26, { 6, 8, 7, 9, 5, 13, 4, 12, 3, 16, 2, 17, 19, 21, 15, 23, 11, 25 } }, // (not proven optimal)
+    { 0x077a, 7, 22, { 6, 8, 7, 9, 3, 12, 2, 13, 11, 15, 4, 16, 18, 21 } },
+    { 0x077e, 8, 25, { 2, 4, 6, 8, 7, 9, 2, 14, 5, 14, 11, 19, 13, 20, 17, 23 } }, // (not proven optimal)
+    { 0x07b0, 7, 23, { 3, 4, 6, 9, 4, 11, 11, 12, 8, 15, 7, 18, 17, 21 } },
+    { 0x07b1, 8, 24, { 3, 8, 2, 9, 6, 8, 5, 13, 6, 12, 17, 19, 11, 20, 15, 23 } }, // (not proven optimal)
+    { 0x07b4, 7, 23, { 3, 4, 4, 7, 8, 13, 11, 15, 7, 17, 6, 16, 19, 21 } },
+    { 0x07b5, 7, 23, { 5, 8, 2, 11, 4, 13, 7, 13, 9, 15, 6, 18, 17, 21 } },
+    { 0x07b6, 9, 26, { 5, 8, 3, 11, 5, 13, 4, 12, 9, 17, 15, 17, 6, 19, 7, 20, 23, 25 } }, // (not proven optimal)
+    { 0x07bc, 7, 22, { 2, 4, 3, 4, 7, 11, 9, 13, 15, 17, 14, 16, 19, 21 } },
+    { 0x07e0, 7, 23, { 3, 5, 2, 4, 7, 8, 6, 9, 13, 14, 11, 16, 19, 21 } },
+    { 0x07e1, 7, 22, { 2, 4, 3, 5, 7, 11, 9, 13, 7, 16, 15, 17, 19, 21 } },
+    { 0x07e2, 7, 22, { 2, 4, 4, 6, 3, 9, 6, 8, 11, 15, 13, 19, 17, 21 } },
+    { 0x07e3, 7, 22, { 4, 7, 4, 9, 3, 13, 9, 15, 10, 15, 6, 17, 19, 21 } },
+    { 0x07e6, 7, 22, { 4, 7, 3, 9, 6, 8, 2, 10, 5, 12, 15, 17, 19, 20 } },
+    { 0x07e9, 7, 22, { 3, 5, 2, 4, 9, 11, 7, 13, 14, 16, 15, 17, 19, 21 } },
+    { 0x07f0, 5, 19, { 2, 4, 7, 8, 6, 9, 11, 12, 15, 17 } },
+    { 0x07f1, 7, 23, { 2, 4, 3, 5, 8, 11, 7, 13, 7, 14, 9, 17, 19, 21 } },
+    { 0x07f2, 6, 21, { 3, 8, 2, 5, 11, 13, 7, 15, 6, 9, 17, 19 } },
+    { 0x07f8, 5, 18, { 2, 4, 7, 11, 8, 13, 9, 12, 15, 17 } },
+    { 0x0ff0, 3, 15, { 7, 8, 6, 9, 11, 13 } },
+    { 0x1668, 14, 37, { 7, 9, 7, 8, 6, 9, 13, 15, 5, 17, 4, 10, 19, 21, 6, 8, 5, 24, 4, 17, 27, 29, 3, 31, 2, 23, 33, 35 } }, // (not proven optimal)
+    { 0x1669, 13, 35, { 7, 9, 7, 8, 6, 9, 13, 15, 5, 17, 4, 10, 19, 21, 5, 16, 4, 17, 25, 27, 3, 29, 2, 23, 31, 33 } }, // (not proven optimal)
+    { 0x166a, 11, 30, { 6, 8, 7, 9, 4, 10, 4, 13, 15, 16, 11, 19, 3, 21, 2, 21, 3, 23, 15, 27, 25, 28 } }, // (not proven optimal)
+    { 0x166b, 14, 37, { 7, 9, 6, 9, 6, 13, 5, 15, 4, 10, 17, 19, 7, 8, 13, 23, 5, 24, 4, 25, 27, 29, 3, 31, 2, 21, 33, 35 } }, // (not proven optimal)
+    { 0x166e, 12, 33, { 7, 9, 6, 9, 6, 13, 5, 15, 4, 10, 17, 19, 5, 14, 4, 15, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x167e, 12, 33, { 7, 9, 6, 9, 6, 13, 5, 15, 4, 10, 17, 19, 5, 6, 4, 15, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x1681, 14, 37, { 6, 9, 7, 8, 5, 12, 4, 10, 15, 17, 7, 9, 6, 8, 21, 23, 5, 25, 4, 12, 27, 29, 3, 31, 2, 19, 33, 35 } }, // (not proven optimal)
+    { 0x1683, 11, 31, { 2, 9, 3, 8, 7, 12, 6, 10, 15, 17, 7, 13, 6, 12, 21, 23, 5, 25, 4, 19, 27, 29 } }, // (not proven optimal)
+    { 0x1686, 11, 31, { 6, 9, 5, 7, 4, 10, 13, 15, 6, 8, 5, 18, 4, 7, 21, 23, 3, 25, 2, 17, 27, 29 } }, // (not proven optimal)
+    { 0x1687, 9, 26, { 3, 8, 6, 8, 5, 10, 4, 13, 2, 16, 15, 19, 6, 20, 7, 21, 23, 25 } }, // (not proven optimal)
+    { 0x1689, 12, 33, { 4, 9, 5, 8, 11, 13, 7, 15, 6, 10, 17, 19, 7, 14, 6, 12, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x168b, 12, 33, { 2, 9, 3, 8, 11, 13, 7, 15, 6, 10, 17, 19, 7, 13, 6, 12, 23, 25, 5, 27, 4, 21, 29, 31 } }, // (not proven optimal)
+    { 0x168e, 10, 29, { 5, 7, 4, 9, 11, 13, 6, 8, 5, 16, 4, 7, 19, 21, 3, 23, 2, 15, 25, 27 } }, // (not proven optimal)
+    { 0x1696, 8, 24, { 3, 5, 2, 4, 8, 12, 11, 13, 6, 16, 7, 17, 15, 21, 19, 22 } }, // (not proven optimal)
+    { 0x1697, 10, 29, { 3, 5, 2, 4, 8, 10, 9, 12, 7, 15, 11, 17, 6, 21, 13, 23, 18, 24, 23, 27 } }, // (not proven optimal)
+    { 0x1698, 10, 29, { 7, 8, 5, 10, 4, 9, 13, 15, 5, 6, 4, 10, 19, 21, 3, 23, 2, 17, 25, 27 } }, // (not proven optimal)
+    { 0x1699, 10, 29, { 7, 8, 5, 10, 4, 9, 13, 15, 5, 11, 4, 10, 19, 21, 3, 23, 2, 17, 25, 27 } }, // (not proven optimal)
+    { 0x169a, 9, 26, { 5, 6, 4, 8, 6, 12, 11, 13, 2, 16, 3, 17, 15, 21, 19, 22, 15, 25 } }, // (not proven optimal)
+    { 0x169b, 10, 29, { 5, 7, 4, 9, 11, 13, 7, 8, 5, 17, 4, 16, 19, 21, 3, 23, 2, 15, 25, 27 } }, // (not proven optimal)
+    { 0x169e, 8, 25, { 2, 4, 3, 5, 9, 10, 6, 12, 7, 13, 11, 18, 17, 21, 15, 22 } }, // (not proven optimal)
+    { 0x16a9, 11, 30, { 3, 8, 2, 8, 5, 8, 4, 11, 3, 15, 15, 16, 13, 19, 7, 21, 22, 24, 23, 25, 27, 29 } }, // (not proven optimal)
+    { 0x16ac, 12, 33, { 5, 8, 4, 9, 11, 13, 7, 15, 6, 9, 17, 19, 4, 7, 6, 10, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x16ad, 12, 33, { 7, 8, 6, 9, 11, 13, 5, 15, 4, 9, 17, 19, 5, 14, 4, 7, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x16bc, 9, 26, { 2, 6, 3, 6, 2, 8, 5, 11, 2, 14, 13, 19, 17, 21, 16, 20, 23, 25 } }, // (not proven optimal)
+    { 0x16e9, 10, 29, { 5, 7, 5, 6, 4, 7, 13, 15, 3, 17, 2, 10, 19, 21, 9, 22, 8, 23, 25, 27 } }, // (not proven optimal)
+    { 0x177e, 12, 33, { 7, 9, 6, 9, 6, 13, 5, 15, 4, 10, 17, 19, 5, 11, 4, 15, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x178e, 8, 25, { 2, 4, 3, 5, 9, 10, 8, 12, 11, 13, 7, 18, 17, 21, 15, 22 } }, // (not proven optimal)
+    { 0x1796, 11, 31, { 6, 9, 5, 7, 4, 10, 13, 15, 9, 11, 5, 19, 4, 7, 21, 23, 3, 25, 2, 17, 27, 29 } }, // (not proven optimal)
+    { 0x1798, 11, 31, { 7, 8, 5, 10, 4, 9, 13, 15, 7, 11, 5, 19, 4, 10, 21, 23, 3, 25, 2, 17, 27, 29 } }, // (not proven optimal)
+    { 0x179a, 8, 24, { 5, 6, 4, 8, 7, 8, 11, 13, 11, 15, 2, 17, 3, 18, 21, 23 } }, // (not proven optimal)
+    { 0x17ac, 8, 25, { 3, 6, 2, 8, 6, 11, 5, 15, 8, 16, 11, 17, 13, 20, 19, 23 } }, // (not proven optimal)
+    { 0x17e8, 7, 23, { 2, 6, 3, 7, 4, 13, 11, 15, 9, 17, 8, 16, 19, 21 } },
+    { 0x18e7, 8, 25, { 4, 7, 5, 6, 3, 12, 2, 10, 15, 17, 9, 18, 8, 19, 21, 23 } }, // (not proven optimal)
+    { 0x19e1, 9, 26, { 7, 8, 6, 9, 2, 11, 2, 15, 5, 15, 13, 17, 19, 20, 18, 21, 23, 25 } }, // (not proven optimal)
+    { 0x19e3, 12, 33, { 7, 8, 6, 9, 11, 13, 5, 9, 4, 15, 17, 19, 5, 13, 4, 12, 23, 25, 3, 27, 2, 21, 29, 31 } }, // (not proven optimal)
+    { 0x19e6, 7, 23, { 4, 7, 3, 5, 2, 10, 13, 15, 9, 16, 8, 17, 19, 21 } },
+    { 0x1bd8, 9, 27, { 4, 9, 7, 8, 11, 13, 6, 9, 5, 8, 17, 19, 3, 21, 2, 15, 23, 25 } }, // (not proven optimal)
+    { 0x1be4, 6, 21, { 3, 5, 2, 7, 11, 13, 9, 14, 8, 15, 17, 19 } },
+    { 0x1ee1, 7, 23, { 3, 5, 9, 11, 8, 10, 13, 15, 7, 16, 6, 17, 19, 21 } },
+    { 0x3cc3, 6, 21, { 7, 8, 6, 9, 11, 13, 5, 14, 4, 15, 17, 19 } },
+    { 0x6996, 9, 27, { 7, 8, 6, 9, 11, 13, 5, 14, 4, 15, 17, 19, 3, 20, 2, 21, 23, 25 } }, // (not proven optimal)
+};
+
+// npn_class[f] is the NPN class of the 4-input function f and npn_transform[f] the transform
+// from the representative: f(x) = neg_out ^ rep(y) with y[i] = x[perm[i]] ^ (bit i of neg_in),
+// stored as (perm index * 16 + neg_in) * 2 + neg_out
+static unsigned char npn_class[1 << 16];
+static unsigned short npn_transform[1 << 16];
+static unsigned int npn_perm[24][4];
+
+static unsigned int
+npn_apply(unsigned int f, const unsigned int* perm, unsigned int neg_in, bool neg_out)
+{
+    unsigned int g = 0;
+    for(unsigned int row = 0;row < 16;++row)
+    {
+        unsigned int from = 0;
+        for(unsigned int i = 0;i < 4;++i)
+            if(((row >> perm[i]) & 0x1) ^ ((neg_in >> i) & 0x1))
+                from |= 1 << i;
+        if(((f >> from) & 0x1) ^ (neg_out ? 1 : 0))
+            g |= 1 << row;
+    }
+    return g;
+}
+
+// the classes are found in increasing order of their smallest member, as in NPN_LIBRARY
+static void
+npn_initialize()
+{
+    static bool initialized = false;
+    if(initialized)
+        return;
+    initialized = true;
+
+    unsigned int perm[4] = {0, 1, 2, 3};
+    for(unsigned int p = 0;p < 24;++p)
+    {
+        copy(perm, perm + 4, npn_perm[p]);
+        next_permutation(perm, perm + 4);
+    }
+    vector<bool> done(1 << 16, false);
+    unsigned int class_num = 0;
+    for(unsigned int f = 0;f < (1 << 16);++f)
+    {
+        if(done[f])
+            continue;
+        assert(class_num < NPN_CLASS_NUM && NPN_LIBRARY[class_num].truth == f);
+        for(unsigned int p = 0;p < 24;++p)
+            for(unsigned int neg_in = 0;neg_in < 16;++neg_in)
+                for(unsigned int neg_out = 0;neg_out < 2;++neg_out)
+                {
+                    unsigned int g = npn_apply(f, npn_perm[p], neg_in, neg_out);
+                    if(done[g])
+                        continue;
+                    done[g] = true;
+                    npn_class[g] = class_num;
+                    npn_transform[g] = (p * 16 + neg_in) * 2 + neg_out;
+                }
+        ++class_num;
+    }
+    assert(class_num == NPN_CLASS_NUM);
+}
+
+
+// the literals of the inputs of the representative for cut function f (leaves in "leaves");
+// an input f doesn't depend on is tied to CONST 0
+static void
+npn_input_lits(unsigned int f, const unsigned int* leaves, unsigned int size, unsigned int* input_lits)
+{
+    unsigned int transform = npn_transform[f];
+    const unsigned int* perm = npn_perm[transform / 32];
+    for(unsigned int i = 0;i < 4;++i)
+    {
+        if(perm[i] < size && CirCut::depends_on(f, perm[i]))
+            input_lits[i] = leaves[perm[i]] * 2 + ((transform / 2 >> i) & 0x1);
+        else
+            input_lits[i] = 0;
+    }
+}
+
+/*************************************************/
+/*   Public member functions about rewriting    */
+/*************************************************/
+// For every AIG gate in dfs order, the function of each 4-input cut is matched with the optimal
+// AIG of its NPN class, which would replace the cone between the cut and the gate:
+// * saved: the MFFC (maximum fanout-free cone) of the gate, only used through the gate
+// * added: the gates of the AIG which don't exist yet, looked up in a strash table of the inputs;
+//          a gate of the MFFC is counted as added since the AIG would keep it alive
+// The cut saving the most is used and the rest of the old MFFC is removed.
+// The cuts are enumerated once, so a cut is checked (and its function computed) again on the
+// current circuit before it is used.
+void
+CirMgr::rewrite()
+{
+    STAT_TIMER("rewrite");
+    npn_initialize();
+
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    vector<unsigned int> level_list;
+    get_level_list(dfs_list, level_list);
+    CirCutMgr cut_mgr(4, REWRITE_CUT_LIMIT);
+    cut_mgr.enumerate(_gate_list, dfs_list, level_list);
+
+    HashMap<StrashKey, unsigned int> strash_map(getHashSize(dfs_list.size()));
+    for(auto& e:dfs_list)
+        if(_gate_list[e]->get_type() == AIG_GATE)
+            strash_map.insert(StrashKey(_gate_list[e]), e);
+
+    vector<uint64_t> truth_list;   // function of the cone gates over the leaves
+    vector<unsigned int> deref;    // fanouts of a gate inside the MFFC
+    vector<bool> is_leaf, in_mffc;
+    IdList cone, mffc, stack;
+    size_t ori_aig_num = _header_A, rewrite_num = 0;
+    for(auto& e:dfs_list)
+    {
+        if(_gate_list[e]->get_type() != AIG_GATE)
+            continue;
+        truth_list.resize(_gate_list.size());
+        deref.resize(_gate_list.size(), 0);
+        is_leaf.resize(_gate_list.size(), false);
+        in_mffc.resize(_gate_list.size(), false);
+
+        int best_gain = 0;
+        unsigned int best_truth = 0, best_size = 0, best_leaves[4];
+        const CirCut* cuts = cut_mgr.get_cuts(e);
+        for(unsigned int c = 1;c < cut_mgr.get_cut_num(e);++c)
+        {
+            const CirCut& cut = cuts[c];
+            for(unsigned int i = 0;i < cut.size();++i)
+                is_leaf[cut.leaf(i)] = true;
+            auto done = [&](unsigned int g)
+            { return is_leaf[g] || _gate_list[g]->get_type() == CONST_GATE || _gate_list[g]->is_visited(); };
+
+            // the cone in topological order; invalid if it reaches another PI or UNDEF gate
+            bool valid = true;
+            cone.clear();
+            stack.assign(1, e);
+            CirGate::reset_visited();
+            while(!stack.empty())
+            {
+                unsigned int g = stack.back();
+                if(done(g))
+                {
+                    stack.pop_back();
+                    continue;
+                }
+                const CirGate* gate = _gate_list[g];
+                if(gate->get_type() != AIG_GATE || cone.size() == REWRITE_CONE_LIMIT)
+                {
+                    valid = false;
+                    break;
+                }
+                unsigned int a = gate->get_i_list()[0].get_gate_p()->get_variable_id();
+                unsigned int b = gate->get_i_list()[1].get_gate_p()->get_variable_id();
+                if(!done(a) || !done(b))
+                {
+                    stack.push_back(a);
+                    stack.push_back(b);
+                    continue;
+                }
+                gate->set_visited();
+                cone.push_back(g);
+                stack.pop_back();
+            }
+            if(!valid)
+            {
+                for(unsigned int i = 0;i < cut.size();++i)
+                    is_leaf[cut.leaf(i)] = false;
+                continue;
+            }
+            truth_list[0] = 0;
+            for(unsigned int i = 0;i < cut.size();++i)
+                truth_list[cut.leaf(i)] = CirCut::var_truth(i);
+            for(auto& g:cone)
+            {
+                const CirGate::RelatedGate& ia = _gate_list[g]->get_i_list()[0];
+                const CirGate::RelatedGate& ib = _gate_list[g]->get_i_list()[1];
+                uint64_t ta = truth_list[ia.get_gate_p()->get_variable_id()];
+                uint64_t tb = truth_list[ib.get_gate_p()->get_variable_id()];
+                truth_list[g] = (ia.is_inverted() ? ~ta : ta) & (ib.is_inverted() ? ~tb : tb);
+            }
+            unsigned int f = truth_list[e] & 0xFFFF;
+
+            // MFFC: the gate and the cone gates whose fanouts are all in the MFFC
+            mffc.assign(1, e);
+            in_mffc[e] = true;
+            for(size_t i = 0;i < mffc.size();++i)
+            {
+                for(auto& input:_gate_list[mffc[i]]->get_i_list())
+                {
+                    unsigned int g = input.get_gate_p()->get_variable_id();
+                    if(is_leaf[g] || _gate_list[g]->get_type() != AIG_GATE)
+                        continue;
+                    if(++deref[g] == _gate_list[g]->get_o_list().size())
+                    {
+                        in_mffc[g] = true;
+                        mffc.push_back(g);
+                    }
+                }
+            }
+
+            // new gates of the AIG, UINT_MAX for a gate to add (and the gates above it)
+            const NpnStructure& npn = NPN_LIBRARY[npn_class[f]];
+            unsigned int node_lits[5 + NPN_MAX_GATE_NUM];
+            node_lits[0] = 0;
+            unsigned int leaves[4];
+            for(unsigned int i = 0;i < cut.size();++i)
+                leaves[i] = cut.leaf(i);
+            npn_input_lits(f, leaves, cut.size(), node_lits + 1);
+            int added_num = 0;
+            for(unsigned int i = 0;i < npn.gate_num;++i)
+            {
+                unsigned int fanin_a = npn.fanins[2 * i], fanin_b = npn.fanins[2 * i + 1];
+                unsigned int lit = UINT_MAX;
+                if(node_lits[fanin_a / 2] != UINT_MAX && node_lits[fanin_b / 2] != UINT_MAX)
+                    lit = find_aig_gate(strash_map, node_lits[fanin_a / 2] ^ (fanin_a & 0x1), node_lits[fanin_b / 2] ^ (fanin_b & 0x1));
+                if(lit != UINT_MAX && in_mffc[lit / 2])
+                    lit = UINT_MAX;
+                if(lit == UINT_MAX)
+                    ++added_num;
+                node_lits[5 + i] = lit;
+            }
+            int gain = (int)mffc.size() - added_num;
+            if(gain > best_gain)
+            {
+                best_gain = gain;
+                best_truth = f;
+                best_size = cut.size();
+                copy(leaves, leaves + cut.size(), best_leaves);
+            }
+
+            for(auto& g:mffc)
+            {
+                in_mffc[g] = false;
+                for(auto& input:_gate_list[g]->get_i_list())
+                    deref[input.get_gate_p()->get_variable_id()] = 0;
+            }
+            for(unsigned int i = 0;i < cut.size();++i)
+                is_leaf[cut.leaf(i)] = false;
+        }
+        if(best_gain == 0)
+            continue;
+
+        // build the AIG, existing gates but this one are reused
+        const NpnStructure& npn = NPN_LIBRARY[npn_class[best_truth]];
+        unsigned int node_lits[5 + NPN_MAX_GATE_NUM];
+        node_lits[0] = 0;
+        npn_input_lits(best_truth, best_leaves, best_size, node_lits + 1);
+        for(unsigned int i = 0;i < npn.gate_num;++i)
+        {
+            unsigned int lit_a = node_lits[npn.fanins[2 * i] / 2] ^ (npn.fanins[2 * i] & 0x1);
+            unsigned int lit_b = node_lits[npn.fanins[2 * i + 1] / 2] ^ (npn.fanins[2 * i + 1] & 0x1);
+            unsigned int lit = find_aig_gate(strash_map, lit_a, lit_b);
+            if(lit == UINT_MAX || lit / 2 == e)
+            {
+                unsigned int gid = add_aig_gate(lit_a, lit_b);
+                strash_map.update(StrashKey(lit_a, lit_b), gid);
+                lit = gid * 2;
+            }
+            node_lits[5 + i] = lit;
+        }
+        unsigned int out_lit = node_lits[npn.output / 2] ^ (npn.output & 0x1) ^ (npn_transform[best_truth] & 0x1);
+
+        IdList inputs;
+        for(auto& input:_gate_list[e]->get_i_list())
+            inputs.push_back(input.get_gate_p()->get_variable_id());
+        merge_gate(e, CirGate::RelatedGate(_gate_list[out_lit / 2], out_lit & 0x1));
+        for(auto& g:inputs)
+            remove_dangling(g);
+        ++rewrite_num;
+    }
+    if(_verbose)
+        cout << "Rewriting: " << rewrite_num << " gate(s) rewritten, AIG " << ori_aig_num << " -> " << _header_A << endl;
+}
@@ -0,0 +1,272 @@
+/****************************************************************************
+  FileName     [ cirSEquiv.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir sequential equivalence (signal correspondence) functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "sat.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const int64 SEQ_CONFLICT_BUDGET = 10000; // a query out of budget splits the gate from its class
+
+/**********************************************************/
+/*   Public member functions about sequential equivalence */
+/**********************************************************/
+// Signal correspondence: the candidates are CONST 0, the PIs, the latches and the AIG gates, and
+// the candidate classes are the ones with the same values (up to inversion) in every cycle of
+// SIM_PATTERN_NUM random traces of "cycle_num" cycles from the initial state.
+// The classes are proved by k-step induction on the time frames of the circuit:
+//   base case: they hold in frames 0 .. k-1 from the initial state (bounded model checking);
+//   induction: if they hold in frames 0 .. k-1 from any state, they hold in frame k.
+// A counterexample splits the classes by its values and the proof restarts on the smaller classes,
+// until it succeeds; then every gate of a class is merged into its first one (the lowest in dfs
+// order, so it is never in the fanin cone of the others).
+void
+CirMgr::sequivalence(unsigned int k, unsigned int cycle_num)
+{
+    STAT_TIMER("sequiv");
+    assert(k > 0 && cycle_num > 0);
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    IdList candidates(1, 0);
+    for(auto& e:dfs_list)
+    {
+        GateType type = _gate_list[e]->get_type();
+        if(type == PI_GATE || type == LATCH_GATE || type == AIG_GATE)
+            candidates.push_back(e);
+    }
+    vector<unsigned int> rank(_gate_list.size(), UINT_MAX);
+    for(size_t i = 0;i < candidates.size();++i)
+        rank[candidates[i]] = i;
+
+    // signatures: sig_list[gid * cycle_num + c] is the value of gate gid in cycle c
+    vector<size_t> sig_list;
+    sim_seq_signatures(dfs_list, cycle_num, sig_list);
+
+    // the classes of literals (variable id * 2 + phase), a gate is inverted if its first value is 1
+    auto sig = [&](unsigned int lit, unsigned int c)
+    { return (lit & 0x1) ? ~sig_list[lit / 2 * cycle_num + c] : sig_list[lit / 2 * cycle_num + c]; };
+    IdList lits;
+    for(auto& e:candidates)
+        lits.push_back(e * 2 + (sig_list[e * cycle_num] & 0x1));
+    sort(lits.begin(), lits.end(), [&](unsigned int a, unsigned int b)
+    {
+        for(unsigned int c = 0;c < cycle_num;++c)
+            if(sig(a, c) != sig(b, c))
+                return sig(a, c) < sig(b, c);
+        return rank[a / 2] < rank[b / 2];
+    });
+    vector<IdList> classes;
+    for(size_t i = 0, j;i < lits.size();i = j)
+    {
+        for(j = i + 1;j < lits.size();++j)
+        {
+            bool equal = true;
+            for(unsigned int c = 0;c < cycle_num && equal;++c)
+                equal = sig(lits[i], c) == sig(lits[j], c);
+            if(!equal)
+                break;
+        }
+        if(j - i > 1)
+            classes.push_back(IdList(lits.begin() + i, lits.begin() + j));
+    }
+    size_t candidate_class_num = classes.size();
+
+    // time frames: frames[f][gid] is the literal of gate gid in frame f, the latches of frame 0 are
+    // free variables, or the initial values if "from_reset"
+    SatSolver solver;
+    vector<vector<Lit> > frames;
+    auto gen_frames = [&](unsigned int frame_num, bool from_reset)
+    {
+        solver.initialize();
+        Var const_var = solver.newVar();
+        solver.assertProperty(const_var, false);
+        frames.assign(frame_num, vector<Lit>(_gate_list.size(), lit_Undef));
+        for(unsigned int f = 0;f < frame_num;++f)
+        {
+            vector<Lit>& frame = frames[f];
+            auto input_lit = [&](const CirGate::RelatedGate& input) // floating UNDEF gates are free
+            {
+                Lit& lit = frame[input.get_gate_p()->get_variable_id()];
+                if(lit == lit_Undef)
+                    lit = Lit(solver.newVar());
+                return input.is_inverted() ? ~lit : lit;
+            };
+            frame[0] = Lit(const_var);
+            for(auto& e:dfs_list)
+            {
+                const CirGate* gate = _gate_list[e];
+                if(gate->get_type() == PI_GATE)
+                    frame[e] = Lit(solver.newVar());
+                else if(gate->get_type() == LATCH_GATE)
+                {
+                    const LATCHGate* latch = static_cast<const LATCHGate*>(gate);
+                    if(f > 0)
+                    {
+                        const CirGate::RelatedGate& next = gate->get_i_list()[0];
+                        Lit& lit = frames[f - 1][next.get_gate_p()->get_variable_id()];
+                        if(lit == lit_Undef)
+                            lit = Lit(solver.newVar());
+                        frame[e] = next.is_inverted() ? ~lit : lit;
+                    }
+                    else if(from_reset && latch->is_initialized())
+                        frame[e] = latch->get_reset() ? ~Lit(const_var) : Lit(const_var);
+                    else
+                        frame[e] = Lit(solver.newVar());
+                }
+                else if(gate->get_type() == AIG_GATE)
+                {
+                    Lit a = input_lit(gate->get_i_list()[0]);
+                    Lit b = input_lit(gate->get_i_list()[1]);
+                    frame[e] = Lit(solver.newVar());
+                    solver.addAigCNF(var(frame[e]), var(a), sign(a), var(b), sign(b));
+                }
+            }
+        }
+    };
+    auto frame_lit = [&](unsigned int f, unsigned int lit) { return id(frames[f][lit / 2], lit & 0x1); };
+    auto model_value = [&](unsigned int f, unsigned int lit)
+    { Lit l = frame_lit(f, lit); return (solver.getModelValue(var(l)) == l_True) != sign(l); };
+
+    // split the classes by the values of the counterexample in frame f, or "lit" from its class
+    vector<unsigned int> class_id(_gate_list.size(), UINT_MAX);
+    auto set_class_id = [&]()
+    {
+        for(size_t i = 0;i < classes.size();++i)
+            for(auto& lit:classes[i])
+                class_id[lit / 2] = i;
+    };
+    auto refine = [&](unsigned int f, unsigned int lit)
+    {
+        vector<IdList> new_classes;
+        IdList same, diff;
+        for(auto& c:classes)
+        {
+            same.clear();
+            diff.clear();
+            bool rep_value = lit == UINT_MAX ? model_value(f, c[0]) : false;
+            for(auto& m:c)
+            {
+                if(lit == UINT_MAX)
+                    (model_value(f, m) == rep_value ? same : diff).push_back(m);
+                else
+                    (m == lit ? diff : same).push_back(m);
+            }
+            for(auto list:{&same, &diff})
+            {
+                if(list->size() > 1)
+                    new_classes.push_back(*list);
+                else if(list->size() == 1)
+                    class_id[(*list)[0] / 2] = UINT_MAX;
+            }
+        }
+        classes.swap(new_classes);
+        set_class_id();
+    };
+    // one pass on the pairs (first gate, gate) in frame f with the clause group "hyp" (if not var_Undef),
+    // true if no pair fails
+    size_t query_num = 0;
+    auto check_pairs = [&](unsigned int f, Var hyp)
+    {
+        vector<pair<unsigned int, unsigned int> > pairs;
+        for(auto& c:classes)
+            for(size_t i = 1;i < c.size();++i)
+                pairs.push_back(make_pair(c[0], c[i]));
+        bool holds = true;
+        for(auto& p:pairs)
+        {
+            if(class_id[p.first / 2] == UINT_MAX || class_id[p.first / 2] != class_id[p.second / 2])
+                continue;
+            Lit a = frame_lit(f, p.first), b = frame_lit(f, p.second);
+            Var miter = solver.newGroup();
+            solver.addGroupXorCNF(miter, var(a), sign(a), var(b), sign(b));
+            solver.assumeRelease();
+            if(hyp != var_Undef)
+                solver.enableGroup(hyp);
+            solver.enableGroup(miter);
+            lbool result = solver.assumpSolveLimited(SEQ_CONFLICT_BUDGET);
+            solver.releaseGroup(miter);
+            ++query_num;
+            if(result == l_False)
+                continue;
+            holds = false;
+            refine(f, result == l_True ? UINT_MAX : p.second);
+        }
+        return holds;
+    };
+
+    // base case
+    set_class_id();
+    gen_frames(k, true);
+    for(bool holds = false;!holds && !classes.empty();)
+    {
+        holds = true;
+        for(unsigned int f = 0;f < k;++f)
+            holds = check_pairs(f, var_Undef) && holds;
+    }
+    // induction step: the classes in frames 0 .. k-1 are a clause group, replaced after a refinement
+    size_t induction_num = 0;
+    gen_frames(k + 1, false);
+    for(bool holds = false;!holds && !classes.empty();++induction_num)
+    {
+        Var hyp = solver.newGroup();
+        vec<Lit> clause;
+        for(auto& c:classes)
+        {
+            for(size_t i = 1;i < c.size();++i)
+            {
+                for(unsigned int f = 0;f < k;++f)
+                {
+                    Lit a = frame_lit(f, c[0]), b = frame_lit(f, c[i]);
+                    clause.clear(); clause.push(~a); clause.push(b);
+                    solver.addGroupClause(hyp, clause);
+                    clause.clear(); clause.push(a); clause.push(~b);
+                    solver.addGroupClause(hyp, clause);
+                }
+            }
+        }
+        holds = check_pairs(k, hyp);
+        solver.releaseGroup(hyp);
+    }
+
+    // merge the proved classes
+    size_t ori_aig_num = _header_A, ori_latch_num = _header_L, merged_num = 0;
+    IdList inputs;
+    for(auto& c:classes)
+    {
+        for(size_t i = 1;i < c.size();++i)
+        {
+            unsigned int gid = c[i] / 2;
+            if(_gate_list[gid]->get_type() == PI_GATE)
+                continue;
+            for(auto& input:_gate_list[gid]->get_i_list())
+                inputs.push_back(input.get_gate_p()->get_variable_id());
+            merge_gate(gid, CirGate::RelatedGate(_gate_list[c[0] / 2], (c[0] ^ c[i]) & 0x1));
+            ++merged_num;
+        }
+    }
+    for(auto& g:inputs)
+        remove_dangling(g);
+    if(_verbose)
+        cout << "Sequential equivalence: " << candidate_class_num << " candidate class(es), " << classes.size()
+             << " proved by " << k << "-step induction (" << induction_num << " pass(es), " << query_num
+             << " SAT queries), " << merged_num << " gate(s) merged, latch " << ori_latch_num << " -> " << _header_L
+             << ", AIG " << ori_aig_num << " -> " << _header_A << endl;
+}
@@ -13,6 +13,7 @@
 #include <cassert>
 #include "cirMgr.h"
 #include "cirGate.h"
+#include "myHash.h"
 #include "util.h"
 
 using namespace std;
@@ -27,20 +28,285 @@ using namespace std;
 /**************************************/
 /*   Static varaibles and functions   */
 /**************************************/
+static const size_t SIM_PATTERN_NUM = sizeof(size_t) * 8; // patterns simulated at the same time
+
+// HashKey for FEC group partition
+class SimValueKey
+{
+public:
+    SimValueKey(size_t v = 0): _value(v) {}
+    size_t operator() () const { return _value; }
+    bool operator == (const SimValueKey& k) const { return _value == k._value; }
+private:
+    size_t _value;
+};
 
 /************************************************/
 /*   Public member functions about Simulation   */
 /************************************************/
+// Stop when the number of FEC groups does not change in "max_fail_times" rounds
 void
 CirMgr::randomSim()
 {
+    STAT_TIMER("sim");
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+
+    const unsigned int max_fail_times = 5 + _gate_list.size() / 2000;
+    unsigned int fail_times = 0;
+    size_t pattern_num = 0;
+    vector<size_t> pi_patterns(_pi_list.size() + _latch_list.size()); // latches are free in one cycle
+    while(fail_times < max_fail_times)
+    {
+        rnGen.fill(pi_patterns.begin(), pi_patterns.end());
+        sim_patterns(pi_patterns, dfs_list);
+        sim_write_log(SIM_PATTERN_NUM);
+        pattern_num += SIM_PATTERN_NUM;
+
+        size_t ori_group_num = _fec_groups.size();
+        bool first_time = !_fec_initialized;
+        sim_update_fec_groups(dfs_list);
+        if(!first_time && ori_group_num == _fec_groups.size())
+            ++fail_times;
+        else
+            fail_times = 0;
+        if(_verbose)
+            cout << "\rTotal #FEC Group = " << _fec_groups.size() << flush;
+        if(_fec_groups.empty())
+            break;
+    }
+    if(_verbose)
+        cout << "\r" << pattern_num << " patterns simulated." << endl;
 }
 
+// All patterns are checked before simulation, nothing is simulated if any pattern is illegal
 void
 CirMgr::fileSim(ifstream& patternFile)
 {
+    STAT_TIMER("sim");
+    vector<string> patterns;
+    string pattern;
+    while(patternFile >> pattern)
+    {
+        if(pattern.size() != _pi_list.size())
+        {
+            cerr << "\nError: Pattern(" << pattern << ") length(" << pattern.size()
+                 << ") does not match the number of inputs(" << _pi_list.size() << ") in a circuit!!" << endl;
+            cout << "0 patterns simulated." << endl;
+            return;
+        }
+        for(auto& ch:pattern)
+        {
+            if(ch != '0' && ch != '1')
+            {
+                cerr << "\nError: Pattern(" << pattern << ") contains a non-0/1 character('" << ch << "')." << endl;
+                cout << "0 patterns simulated." << endl;
+                return;
+            }
+        }
+        patterns.push_back(pattern);
+    }
+
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    sim_reset_latches();
+
+    vector<size_t> pi_patterns(_pi_list.size());
+    for(size_t i = 0;i < patterns.size();i += SIM_PATTERN_NUM)
+    {
+        size_t batch_num = patterns.size() - i;
+        if(batch_num > SIM_PATTERN_NUM)
+            batch_num = SIM_PATTERN_NUM;
+        fill(pi_patterns.begin(), pi_patterns.end(), 0);
+        for(size_t j = 0;j < batch_num;++j)
+            for(size_t k = 0;k < _pi_list.size();++k)
+                if(patterns[i + j][k] == '1')
+                    pi_patterns[k] |= ((size_t)1 << j);
+        sim_patterns(pi_patterns, dfs_list);
+        sim_write_log(batch_num);
+        sim_update_fec_groups(dfs_list);
+        cout << "\rTotal #FEC Group = " << _fec_groups.size() << flush;
+    }
+    cout << "\r" << patterns.size() << " patterns simulated." << endl;
+}
+
+// SIM_PATTERN_NUM traces from the initial state, one per bit, with random inputs in every cycle;
+// the next states are copied to the latches between cycles
+void
+CirMgr::seqSim(unsigned int cycle_num)
+{
+    STAT_TIMER("seqsim");
+    IdList dfs_list;
+    get_dfs_list(dfs_list);
+    sim_reset_latches();
+
+    vector<size_t> pi_patterns(_pi_list.size());
+    vector<size_t> next_states(_latch_list.size());
+    for(unsigned int c = 0;c < cycle_num;++c)
+    {
+        if(c > 0)
+        {
+            for(size_t i = 0;i < _latch_list.size();++i)
+                next_states[i] = _gate_list[_latch_list[i]]->get_i_list()[0].get_sim_value();
+            for(size_t i = 0;i < _latch_list.size();++i)
+                _gate_list[_latch_list[i]]->set_sim_value(next_states[i]);
+        }
+        rnGen.fill(pi_patterns.begin(), pi_patterns.end());
+        sim_patterns(pi_patterns, dfs_list);
+        sim_write_log(SIM_PATTERN_NUM);
+        sim_update_fec_groups(dfs_list);
+        if(_verbose)
+            cout << "\rTotal #FEC Group = " << _fec_groups.size() << flush;
+    }
+    if(_verbose)
+        cout << "\r" << (size_t)cycle_num * SIM_PATTERN_NUM << " patterns simulated (" << SIM_PATTERN_NUM
+             << " traces of " << cycle_num << " cycles)." << endl;
 }
 
 /*************************************************/
 /*   Private member functions about Simulation   */
 /*************************************************/
+// pi_patterns[i] is the patterns of _pi_list[i], then of _latch_list[i - #PI] if they are given;
+// otherwise the latches keep their values
+void
+CirMgr::sim_patterns(const vector<size_t>& pi_patterns, const IdList& dfs_list)
+{
+    assert(pi_patterns.size() == _pi_list.size() || pi_patterns.size() == _pi_list.size() + _latch_list.size());
+    for(size_t i = 0;i < _pi_list.size();++i)
+        _gate_list[_pi_list[i]]->set_sim_value(pi_patterns[i]);
+    for(size_t i = _pi_list.size();i < pi_patterns.size();++i)
+        _gate_list[_latch_list[i - _pi_list.size()]]->set_sim_value(pi_patterns[i]);
+    for(auto& e:dfs_list)
+        _gate_list[e]->simulate();
+    STAT_ADD(STAT_SIM_WORDS, dfs_list.size());
+}
+
+// "word_num" rounds of random simulation, sig_list[gid * word_num + i] is the value of gate gid in round i
+void
+CirMgr::sim_signatures(const IdList& dfs_list, size_t word_num, vector<size_t>& sig_list)
+{
+    sig_list.assign(_gate_list.size() * word_num, 0);
+    vector<size_t> pi_patterns(_pi_list.size() + _latch_list.size());
+    for(size_t i = 0;i < word_num;++i)
+    {
+        rnGen.fill(pi_patterns.begin(), pi_patterns.end());
+        sim_patterns(pi_patterns, dfs_list);
+        for(size_t g = 0;g < _gate_list.size();++g)
+            sig_list[g * word_num + i] = _gate_list[g]->get_sim_value();
+    }
+}
+
+// "cycle_num" cycles of random simulation from the initial state, sig_list[gid * cycle_num + c]
+// is the value of gate gid in cycle c
+void
+CirMgr::sim_seq_signatures(const IdList& dfs_list, unsigned int cycle_num, vector<size_t>& sig_list)
+{
+    sig_list.assign(_gate_list.size() * cycle_num, 0);
+    vector<size_t> pi_patterns(_pi_list.size());
+    vector<size_t> next_states(_latch_list.size());
+    sim_reset_latches();
+    for(unsigned int c = 0;c < cycle_num;++c)
+    {
+        if(c > 0)
+        {
+            for(size_t i = 0;i < _latch_list.size();++i)
+                next_states[i] = _gate_list[_latch_list[i]]->get_i_list()[0].get_sim_value();
+            for(size_t i = 0;i < _latch_list.size();++i)
+                _gate_list[_latch_list[i]]->set_sim_value(next_states[i]);
+        }
+        rnGen.fill(pi_patterns.begin(), pi_patterns.end());
+        sim_patterns(pi_patterns, dfs_list);
+        for(auto& e:dfs_list)
+            sig_list[e * cycle_num + c] = _gate_list[e]->get_sim_value();
+    }
+}
+
+// the initial states, random for the uninitialized latches
+void
+CirMgr::sim_reset_latches()
+{
+    for(auto& e:_latch_list)
+    {
+        const LATCHGate* latch = static_cast<const LATCHGate*>(_gate_list[e]);
+        if(!latch->is_initialized())
+            _gate_list[e]->set_sim_value(rnGen.next());
+        else
+            _gate_list[e]->set_sim_value(latch->get_reset() ? ~(size_t)0 : 0);
+    }
+}
+
+// write the first "pattern_num" patterns in _simLog as "<PI values> <PO values>"
+void
+CirMgr::sim_write_log(size_t pattern_num) const
+{
+    if(!_simLog)
+        return;
+    for(size_t i = 0;i < pattern_num;++i)
+    {
+        for(auto& e:_pi_list)
+            (*_simLog) << ((_gate_list[e]->get_sim_value() >> i) & 0x1);
+        (*_simLog) << ' ';
+        for(auto& e:_po_list)
+            (*_simLog) << ((_gate_list[e]->get_sim_value() >> i) & 0x1);
+        (*_simLog) << '\n';
+    }
+}
+
+// Split every FEC group by the current simulation values
+// gates not in dfs_list (merged or dangling) are removed from the groups
+void
+CirMgr::sim_update_fec_groups(const IdList& dfs_list)
+{
+    vector<bool> in_dfs_list(_gate_list.size(), false);
+    for(auto& e:dfs_list)
+        in_dfs_list[e] = true;
+    in_dfs_list[0] = true; // CONST 0 is always a candidate
+
+    if(!_fec_initialized)
+    {
+        _fec_initialized = true;
+        IdList first_group;
+        first_group.push_back(0);
+        for(auto& e:dfs_list)
+            if(_gate_list[e]->get_type() == AIG_GATE)
+                first_group.push_back(e * 2);
+        sort(first_group.begin(), first_group.end());
+        _fec_groups.push_back(first_group);
+    }
+
+    vector<IdList> new_fec_groups;
+    for(const IdList& group:_fec_groups)
+    {
+        HashMap<SimValueKey, size_t> group_map(getHashSize(group.size()));
+        for(const unsigned int& lit:group)
+        {
+            unsigned int gid = lit / 2;
+            if(!in_dfs_list[gid] || _gate_list[gid]->get_type() == UNDEF_GATE)
+                continue;
+            size_t value = _gate_list[gid]->get_sim_value();
+            bool inverted = value & 0x1; // a gate and its inverse share the same key
+            SimValueKey key(inverted ? ~value : value);
+            size_t index;
+            if(!group_map.query(key, index))
+            {
+                index = new_fec_groups.size();
+                group_map.insert(key, index);
+                new_fec_groups.push_back(IdList());
+            }
+            new_fec_groups[index].push_back(gid * 2 + (inverted ? 1 : 0));
+        }
+    }
+
+    _fec_groups.clear();
+    for(auto& group:new_fec_groups)
+    {
+        if(group.size() < 2)
+            continue;
+        if(group[0] % 2) // make the first gate not inverted
+            for(auto& lit:group)
+                lit ^= 0x1;
+        _fec_groups.push_back(group);
+    }
+    sort(_fec_groups.begin(), _fec_groups.end());
+    STAT_FEC(_fec_groups);
+}
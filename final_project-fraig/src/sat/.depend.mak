@@ -1,4 +1,6 @@
 File.o: File.cpp File.h Global.h
 Proof.o: Proof.cpp Proof.h SolverTypes.h Global.h File.h Sort.h
+Simplifier.o: Simplifier.cpp Simplifier.h Solver.h SolverTypes.h Global.h \
+ VarOrder.h Heap.h Proof.h File.h Portfolio.h Sort.h
 Solver.o: Solver.cpp Solver.h SolverTypes.h Global.h VarOrder.h Heap.h \
- Proof.h File.h Sort.h
+ Proof.h File.h Portfolio.h Sort.h
@@ -1,4 +1,4 @@
-sat.d: ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h ../../include/VarOrder.h ../../include/Proof.h ../../include/Global.h ../../include/File.h ../../include/Heap.h ../../include/Sort.h 
+sat.d: ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h ../../include/VarOrder.h ../../include/Proof.h ../../include/Global.h ../../include/File.h ../../include/Heap.h ../../include/Sort.h ../../include/Portfolio.h ../../include/Simplifier.h 
 ../../include/sat.h: sat.h
 	@rm -f ../../include/sat.h
 	@ln -fs ../src/sat/sat.h ../../include/sat.h
@@ -26,3 +26,9 @@ sat.d: ../../include/sat.h ../../include/Solver.h ../../include/SolverTypes.h ..
 ../../include/Sort.h: Sort.h
 	@rm -f ../../include/Sort.h
 	@ln -fs ../src/sat/Sort.h ../../include/Sort.h
+../../include/Portfolio.h: Portfolio.h
+	@rm -f ../../include/Portfolio.h
+	@ln -fs ../src/sat/Portfolio.h ../../include/Portfolio.h
+../../include/Simplifier.h: Simplifier.h
+	@rm -f ../../include/Simplifier.h
+	@ln -fs ../src/sat/Simplifier.h ../../include/Simplifier.h
@@ -0,0 +1,45 @@
+/****************************************************************************
+  FileName     [ Dimacs.h ]
+  PackageName  [ sat ]
+  Synopsis     [ Read a DIMACS CNF file into a Solver ]
+  Author       [ Chung-Yang (Ric) Huang, Cheng-Yin Wu ]
+  Copyright    [ Copyleft(c) 2010-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef DIMACS_H
+#define DIMACS_H
+
+#include <cstdio>
+#include "Solver.h"
+
+// Add the clauses of the DIMACS CNF file "in" to "S"; variables are created
+// as needed. Return false on a syntax error ("S" may be partially filled).
+static inline bool
+parseDimacs(FILE* in, Solver& S)
+{
+   int c;
+   vec<Lit> lits;
+   while ((c = fgetc(in)) != EOF) {
+      if (c == 'c' || c == 'p') {   // comment or problem line
+         while ((c = fgetc(in)) != EOF && c != '\n') ;
+         continue;
+      }
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+         continue;
+      ungetc(c, in);
+      int lit;
+      if (fscanf(in, "%d", &lit) != 1)
+         return false;
+      if (lit == 0) {
+         S.addClause(lits);
+         lits.clear();
+         continue;
+      }
+      Var v = (lit > 0 ? lit : -lit) - 1;
+      while (v >= S.nVars()) S.newVar();
+      lits.push(lit > 0 ? Lit(v) : ~Lit(v));
+   }
+   return lits.size() == 0;   // (the last clause must be terminated)
+}
+
+#endif // DIMACS_H
@@ -19,7 +19,7 @@
 // A buffered file abstraction with only 'putChar()' and 'getChar()'.
 
 
-#define File_BufSize 1024   // A small buffer seem to work just as fine as a big one (at least under Linux)
+#define File_BufSize 65536  // (large enough to keep the number of system calls low when logging big proofs)
 
 enum FileMode { READ, WRITE };
 
@@ -57,6 +57,15 @@ public:
     bool null(void) {               // TRUE if no file is opened.
         return fd == -1; }
 
+    int descriptor(void) {          // Underlying file descriptor (e.g. for 'mmap()'); -1 if no file is opened.
+        return fd; }
+
+    void adviseSequential(void) {   // Hint the kernel that the file is streamed (read-ahead, early page reclaim).
+      #ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+      #endif
+    }
+
     int releaseDescriptor(void) {   // Don't run UNIX function 'close()' on descriptor in 'File's 'close()'.
         if (mode == READ)
             lseek64(fd, pos - size, SEEK_CUR);
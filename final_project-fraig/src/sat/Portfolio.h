@@ -0,0 +1,121 @@
+/*************************************************************************************[Portfolio.h]
+MiniSat -- Copyright (c) 2003-2005, Niklas Een, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Portfolio_h
+#define Portfolio_h
+
+#include "SolverTypes.h"
+#include <atomic>
+
+
+//=================================================================================================
+// State shared by the solvers of a portfolio (same problem, solved by several 'Solver's in
+// parallel threads): a stop flag raised by the first one to finish, and the exchange of short
+// learnt clauses.
+//
+// Every solver publishes into its own ring buffer (so there is a single writer per ring) and reads
+// the rings of the others at its own pace. Nothing is locked: a slot carries a sequence number
+// which is odd while it is written, and a reader keeps a copy only if the number is the same (and
+// even) before and after copying. A reader which falls more than a ring behind loses the
+// overwritten clauses, which is harmless.
+
+
+class Portfolio {
+public:
+    enum { max_size = 8, ring_size = 4096 };    // Longest clause exchanged; slots per ring.
+
+private:
+    struct Slot {
+        std::atomic<uint64>     seq;        // 2 * (position + 1) once written, odd while writing.
+        std::atomic<int>        size;
+        std::atomic<int>        lits[max_size];
+    };
+    struct Ring {
+        std::atomic<uint64>     head;       // Number of clauses published so far.
+        Slot                    slots[ring_size];
+    };
+
+    int                 n;
+    Ring*               rings;
+    vec<vec<uint64> >   cursor;             // 'cursor[to][from]': next position of ring 'from' to be read by 'to'.
+    std::atomic<bool>   stop_flag;
+
+public:
+    Portfolio(int n_solvers) : n(n_solvers), rings(new Ring[n_solvers]), stop_flag(false)
+    {
+        cursor.growTo(n);
+        for (int i = 0; i < n; i++){
+            cursor[i].growTo(n, 0);
+            rings[i].head.store(0, std::memory_order_relaxed);
+            for (int j = 0; j < ring_size; j++)
+                rings[i].slots[j].seq.store(0, std::memory_order_relaxed); }
+    }
+   ~Portfolio() { delete [] rings; }
+
+    int     size   () const { return n; }
+    bool    stopped() const { return stop_flag.load(std::memory_order_relaxed); }
+    void    stop   ()       { stop_flag.store(true, std::memory_order_relaxed); }
+    void    restart()       { stop_flag.store(false, std::memory_order_relaxed); }   // (before the next parallel solve)
+
+    // Publish clause 'c' (at most 'max_size' literals) learnt by solver 'from'.
+    void put(int from, const vec<Lit>& c)
+    {
+        assert(c.size() <= max_size);
+        Ring&   r   = rings[from];
+        uint64  pos = r.head.load(std::memory_order_relaxed);
+        Slot&   s   = r.slots[pos % ring_size];
+        s.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.size.store(c.size(), std::memory_order_relaxed);
+        for (int i = 0; i < c.size(); i++)
+            s.lits[i].store(index(c[i]), std::memory_order_relaxed);
+        s.seq.store(2 * pos + 2, std::memory_order_release);
+        r.head.store(pos + 1, std::memory_order_release);
+    }
+
+    // Append the clauses published by the other solvers since the last call by solver 'to' to
+    // 'lits', each one followed by 'lit_Undef'.
+    void get(int to, vec<Lit>& lits)
+    {
+        for (int from = 0; from < n; from++){
+            if (from == to) continue;
+            Ring&   r    = rings[from];
+            uint64  head = r.head.load(std::memory_order_acquire);
+            uint64& pos  = cursor[to][from];
+            if (head - pos > ring_size) pos = head - ring_size;     // (the older ones are overwritten)
+            for (; pos < head; pos++){
+                Slot&   s     = r.slots[pos % ring_size];
+                int     start = lits.size();
+                if (s.seq.load(std::memory_order_acquire) != 2 * pos + 2) continue;
+                int     sz    = s.size.load(std::memory_order_relaxed);
+                for (int i = 0; i < sz; i++)
+                    lits.push(toLit(s.lits[i].load(std::memory_order_relaxed)));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != 2 * pos + 2)
+                    lits.shrink(lits.size() - start);   // (overwritten while copying)
+                else
+                    lits.push(lit_Undef);
+            }
+        }
+    }
+};
+
+
+//=================================================================================================
+#endif
@@ -20,6 +20,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "Proof.h"
 #include "Sort.h"
 #include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+#include <sys/mman.h>
 
 //=================================================================================================
 // Temporary files handling:
@@ -69,6 +73,7 @@ static TempFiles temp_files;       // (should be singleton)
 Proof::Proof()
 {
     fp_name    = temp_files.open(fp);
+    fp.adviseSequential();
     id_counter = 0;
     trav       = NULL;
     TRA_INT    = 0;
@@ -158,10 +163,156 @@ void Proof::deleted(ClauseId gone)
 // Read-back methods:
 
 
+// Read-only memory map of everything logged so far. The proof file is only read through this map,
+// so 'traverse()' and 'compress()' decode straight from the page cache and 'compress()' can jump
+// to the record of any clause. If 'mmap()' fails, the file is read into memory instead; if that
+// fails too, 'ok()' is false and the proof cannot be read back.
+//
+class ProofMap {
+    File&   fp;
+    bool    mapped;
+
+public:
+    const uchar*    data;
+    int64           size;
+
+    ProofMap(File& fp_) : fp(fp_), mapped(false), data(NULL)
+    {
+        assert(fp.getMode() == WRITE);
+        fp.flush();
+        size = fp.tell();
+        if (size <= 0) return;
+        void* m = mmap(NULL, size, PROT_READ, MAP_SHARED, fp.descriptor(), 0);
+        if (m != MAP_FAILED){
+            madvise(m, size, MADV_SEQUENTIAL);
+            data = (const uchar*)m; mapped = true; return; }
+        std::cerr << "Error: cannot map the proof file (" << strerror(errno) << "), reading it into memory" << std::endl;
+        uchar* buf = (uchar*)malloc(size);
+        int64  got = 0;
+        while (buf != NULL && got < size){
+            ssize_t n = pread(fp.descriptor(), buf + got, size - got, got);
+            if (n <= 0){ free(buf); buf = NULL; }
+            else got += n; }
+        if (buf == NULL)
+            std::cerr << "Error: cannot read the proof file back!!" << std::endl;
+        data = buf;
+    }
+
+   ~ProofMap() { if (data != NULL){ if (mapped) munmap((void*)data, size); else free((void*)data); } }
+
+    bool ok() const { return size <= 0 || data != NULL; }
+};
+
+
+// Same as 'getUInt(File&)', reading from memory.
+static inline uint64 getUInt(const uchar*& p)
+{
+    uint byte0 = *p++;
+    if (!(byte0 & 0x80))
+        return byte0;
+    switch ((byte0 & 0x60) >> 5){
+    case 0:  p += 1; return ((byte0 & 0x1F) << 8)  |  p[-1];
+    case 1:  p += 2; return ((byte0 & 0x1F) << 16) | (p[-2] << 8)  |  p[-1];
+    case 2:  p += 3; return ((byte0 & 0x1F) << 24) | (p[-3] << 16) | (p[-2] << 8) | p[-1];
+    default:
+        uint64 val = 0;
+        for (int i = 0; i < 8; i++)
+            val = (val << 8) | *p++;
+        return val;
+    }
+}
+
+
+// Decode the record at 'p' (which is moved past it), 'id' being the ID of the next clause. A root
+// clause is put in 'clause' (and its partition in 'A'), a derivation or deletion in 'chain_id' and
+// 'chain_lit' (empty for a deletion).
+//
+enum { rec_Root, rec_Chain, rec_Deleted };
+
+int Proof::getRecord(const uchar*& p, ClauseId id, bool& A)
+{
+    uint64  tmp = getUInt(p);
+    if ((tmp & 1) == 0){
+        // Root clause:
+        clause.clear();
+        int idx = tmp >> 1;
+        clause.push(toLit(idx));
+        for(;;){
+            tmp = getUInt(p);
+            if (tmp == 0) break;
+            idx += tmp;
+            clause.push(toLit(idx));
+        }
+        A = getUInt(p) == 1;
+        return rec_Root;
+
+    }else{
+        // Derivation or Deletion:
+        chain_id .clear();
+        chain_lit.clear();
+        chain_id.push(id - (tmp >> 1));
+        for(;;){
+            tmp = getUInt(p);
+            if (tmp == 0) break;
+            chain_lit.push(toLit(tmp - 1));
+            tmp = getUInt(p);
+            chain_id.push(id - tmp);
+        }
+        return chain_lit.size() == 0 ? rec_Deleted : rec_Chain;
+    }
+}
+
+
+// Copy the clauses 'goal' depends on into 'dst', renumbered in the same order. Deletions are dropped.
+//
 void Proof::compress(Proof& dst, ClauseId goal)
 {
     assert(!fp.null());
-    assert(false);  // Not yet!    
+    if (goal == ClauseId_NULL)
+        goal = last();
+
+    ProofMap        map(fp);
+    const uchar*    p;
+    bool            A;
+    if (!map.ok()) return;
+
+    // Locate the record of every clause:
+    vec<int64>  offset;
+    p = map.data;
+    for (ClauseId id = 0; id <= goal; id++){
+        assert(p < map.data + map.size);
+        int64 off = p - map.data;
+        if (getRecord(p, id, A) == rec_Deleted)
+            id--;
+        else
+            offset.push(off);
+    }
+
+    // Mark the clauses in the cone of 'goal' (antecedents always come first):
+    vec<char>   used(goal + 1, 0);
+    used[goal] = 1;
+    for (ClauseId id = goal; id >= 0; id--){
+        if (!used[id]) continue;
+        p = map.data + offset[id];
+        if (getRecord(p, id, A) == rec_Chain)
+            for (int i = 0; i < chain_id.size(); i++)
+                used[chain_id[i]] = 1;
+    }
+
+    // Replay them into 'dst':
+    vec<ClauseId>   new_id(goal + 1, ClauseId_NULL);
+    for (ClauseId id = 0; id <= goal; id++){
+        if (!used[id]) continue;
+        p = map.data + offset[id];
+        if (getRecord(p, id, A) == rec_Root)
+            new_id[id] = dst.addRoot(clause, A);
+        else{
+            dst.beginChain(new_id[chain_id[0]]);
+            for (int i = 0; i < chain_lit.size(); i++)
+                dst.resolve(new_id[chain_id[i+1]], chain_lit[i]);
+            new_id[id] = dst.endChain();
+        }
+    }
 }
 
 
@@ -169,21 +320,14 @@ bool Proof::save(cchar* filename)
 {
     assert(!fp.null());
 
-    // Switch to read mode:
-    fp.setMode(READ);
-    fp.seek(0);
-
-    // Copy file:
     File    out(filename, "wox");
     if (out.null())
         return false;
 
-    while (!fp.eof())
-        out.putChar(fp.getChar());
-
-    // Restore write (proof-logging) mode:
-    fp.seek(0, SEEK_END);
-    fp.setMode(WRITE);
+    ProofMap map(fp);
+    if (!map.ok()) return false;
+    for (int64 i = 0; i < map.size; i++)
+        out.putCharQ(map.data[i]);
     return true;
 }
 
@@ -192,60 +336,24 @@ void Proof::traverse(ProofTraverser& trav, ClauseId goal)
 {
     assert(!fp.null());
 
-    // Switch to read mode:
-    fp.setMode(READ);
-    fp.seek( fpos );
-
-    // Traverse proof:
+    // Traverse proof (from where the last traversal stopped):
     if (goal == ClauseId_NULL)
         goal = last();
 
-    uint64  tmp;
-    int     idx;
-    bool    A; 
+    ProofMap        map(fp);
+    if (!map.ok()) return;
+    const uchar*    p = map.data + fpos;
+    bool            A;
 
     for(ClauseId id = TRA_INT ; id <= goal; id++){
-        tmp = getUInt(fp);
-        if ((tmp & 1) == 0){
-            // Root clause:
-            clause.clear();
-            idx = tmp >> 1;
-            clause.push(toLit(idx));
-            for(;;){
-                tmp = getUInt(fp);
-                if (tmp == 0) break;
-                idx += tmp;
-                clause.push(toLit(idx));
-            }
-            if( getUInt(fp) == 1 ) A = true;
-            else A = false;
-            //assert( false);
-            trav.root(clause ,A);
-        
-
-        }else{
-            // Derivation or Deletion:
-            
-            chain_id .clear();
-            chain_lit.clear();
-            chain_id.push(id - (tmp >> 1));
-            for(;;){
-                tmp = getUInt(fp);
-                if (tmp == 0) break;
-                chain_lit.push(toLit( tmp - 1));
-                tmp = getUInt(fp);
-                chain_id.push(id - tmp);
-            }
-
-            if (chain_lit.size() == 0)
-                id--,   // (no new clause introduced)
-                trav.deleted(chain_id[0]);
-            else
-                trav.chain(chain_id, chain_lit);
+        assert(p < map.data + map.size);
+        switch (getRecord(p, id, A)){
+        case rec_Root:    trav.root(clause, A); break;
+        case rec_Chain:   trav.chain(chain_id, chain_lit); break;
+        case rec_Deleted: id--;     // (no new clause introduced)
+                          trav.deleted(chain_id[0]); break;
         }
     }
     TRA_INT = goal+1;
-    fpos = fp.tell();
-    fp.seek(0, SEEK_END);
-    fp.setMode(WRITE);
+    fpos = p - map.data;
 }
@@ -53,6 +53,8 @@ class Proof {
     vec<ClauseId>   chain_id;
     vec<Lit>        chain_lit;
 
+    int      getRecord (const uchar*& p, ClauseId id, bool& A);
+
 public:
     Proof();                        // Offline mode -- proof stored to a file, which can be saved, compressed, and/or traversed.
     Proof(ProofTraverser& t);       // Online mode -- proof will not be stored.
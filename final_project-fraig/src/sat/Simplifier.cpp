@@ -0,0 +1,474 @@
+/**********************************************************************************[Simplifier.C]
+MiniSat -- Copyright (c) 2003-2005, Niklas Een, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "Simplifier.h"
+#include "Sort.h"
+
+
+//=================================================================================================
+// Helpers:
+
+
+static inline uint64 abstractLevel(const vec<Lit>& ps)
+{
+    uint64  abst = 0;
+    for (int i = 0; i < ps.size(); i++)
+        abst |= (uint64)1 << (var(ps[i]) & 63);
+    return abst;
+}
+
+
+// Returns 'lit_Undef' if 'ps' is a subset of 'qs', 'p' if 'ps' with 'p' flipped is a subset of
+// 'qs' (so '~p' can be removed from 'qs'), and 'lit_Error' otherwise.
+static Lit subsumes(const vec<Lit>& ps, const vec<Lit>& qs)
+{
+    Lit     ret = lit_Undef;
+    for (int i = 0; i < ps.size(); i++){
+        for (int j = 0; j < qs.size(); j++){
+            if (ps[i] == qs[j])
+                goto found;
+            else if (ret == lit_Undef && ps[i] == ~qs[j]){
+                ret = ps[i];
+                goto found; }
+        }
+        return lit_Error;
+    found:;
+    }
+    return ret;
+}
+
+
+static void removeElem(vec<int>& ws, int elem)
+{
+    int     j = 0;
+    for (; ws[j] != elem; j++) assert(j < ws.size());
+    for (; j < ws.size()-1; j++) ws[j] = ws[j+1];
+    ws.pop();
+}
+
+
+//=================================================================================================
+// Clause database:
+
+
+Simplifier::~Simplifier()
+{
+    for (int i = 0; i < clauses.size(); i++)
+        delete clauses[i];
+}
+
+
+Var Simplifier::newVar()
+{
+    int     index = nVars();
+    assigns    .push(l_Undef);
+    occurs     .push();
+    occurs     .push();
+    frozen     .push(0);
+    eliminated .push(0);
+    subst      .push(lit_Undef);
+    return index;
+}
+
+
+void Simplifier::addClause(const vec<Lit>& ps)
+{
+    vec<Lit>    qs;
+    ps.copyTo(qs);
+    attach(qs);
+}
+
+
+void Simplifier::attach(vec<Lit>& ps)
+{
+    if (!ok) return;
+
+    // Remove duplicates, false literals, and satisfied or tautological clauses:
+    sortUnique(ps);
+    int     i, j;
+    for (i = j = 0; i < ps.size(); i++){
+        if (value(ps[i]) == l_True || (i+1 < ps.size() && ps[i] == ~ps[i+1]))
+            return;
+        if (value(ps[i]) == l_Undef)
+            ps[j++] = ps[i];
+    }
+    ps.shrink(i - j);
+
+    if (ps.size() == 0)
+        ok = false;
+    else if (ps.size() == 1)
+        enqueue(ps[0]);
+    else{
+        SClause*    c = new SClause;
+        ps.copyTo(c->lits);
+        c->abst    = abstractLevel(ps);
+        c->deleted = false;
+        int     ci = clauses.size();
+        clauses.push(c);
+        for (int k = 0; k < ps.size(); k++)
+            occurs[index(ps[k])].push(ci);
+        subsumption_queue.push(ci);
+    }
+}
+
+
+void Simplifier::removeClause(int ci)
+{
+    SClause&    c = *clauses[ci];
+    assert(!c.deleted);
+    for (int i = 0; i < c.lits.size(); i++)
+        removeElem(occurs[index(c.lits[i])], ci);
+    c.deleted = true;
+}
+
+
+void Simplifier::strengthen(int ci, Lit p)
+{
+    SClause&    c = *clauses[ci];
+    int         j = 0;
+    for (; c.lits[j] != p; j++) assert(j < c.lits.size());
+    for (; j < c.lits.size()-1; j++) c.lits[j] = c.lits[j+1];
+    c.lits.pop();
+    removeElem(occurs[index(p)], ci);
+    n_strengthened++;
+
+    if (c.lits.size() == 1){
+        Lit     unit = c.lits[0];
+        removeClause(ci);
+        enqueue(unit);
+    }else{
+        c.abst = abstractLevel(c.lits);
+        subsumption_queue.push(ci);
+    }
+}
+
+
+void Simplifier::enqueue(Lit p)
+{
+    if (value(p) == l_False)
+        ok = false;
+    else if (value(p) == l_Undef){
+        assigns[var(p)] = sign(p) ? l_False : l_True;
+        units.push(p);
+    }
+}
+
+
+// Remove the clauses satisfied by the top-level assignment and the false literals from the rest.
+void Simplifier::propagate()
+{
+    vec<int>    cs;
+    while (ok && units_head < units.size()){
+        Lit     p = units[units_head++];
+        occurs[index(p)].copyTo(cs);
+        for (int i = 0; i < cs.size(); i++)
+            removeClause(cs[i]);
+        occurs[index(~p)].copyTo(cs);
+        for (int i = 0; i < cs.size() && ok; i++)
+            strengthen(cs[i], ~p);
+    }
+}
+
+
+//=================================================================================================
+// Simplification steps:
+
+
+// Find the equivalent literals (strongly connected components of the implication graph of the
+// binary clauses) and replace each of them by one representative. A frozen variable is never
+// replaced, so it is the representative if it can be.
+//
+bool Simplifier::substituteEquivalences()
+{
+    int             n = 2 * nVars();
+    vec<vec<Lit> >  imp(n);         // 'imp[index(p)]': 'p' implies these.
+    for (int i = 0; i < clauses.size(); i++){
+        const SClause& c = *clauses[i];
+        if (c.deleted || c.lits.size() != 2) continue;
+        imp[index(~c.lits[0])].push(c.lits[1]);
+        imp[index(~c.lits[1])].push(c.lits[0]);
+    }
+
+    // Tarjan's algorithm (with an explicit stack):
+    vec<int>    num(n, -1), low(n, 0), comp(n, -1);
+    vec<int>    stack, call_node, call_edge;
+    int         counter = 0, n_comps = 0;
+    for (int s = 0; s < n; s++){
+        if (num[s] != -1 || imp[s].size() == 0) continue;
+        num[s] = low[s] = counter++;
+        stack.push(s); call_node.push(s); call_edge.push(0);
+        while (call_node.size() > 0){
+            int     u = call_node.last();
+            int     e = call_edge.last();
+            if (e < imp[u].size()){
+                call_edge.last()++;
+                int w = index(imp[u][e]);
+                if (num[w] == -1){
+                    num[w] = low[w] = counter++;
+                    stack.push(w); call_node.push(w); call_edge.push(0);
+                }else if (comp[w] == -1)
+                    low[u] = min(low[u], num[w]);
+            }else{
+                if (low[u] == num[u]){
+                    int w;
+                    do{ w = stack.last(); stack.pop(); comp[w] = n_comps; }while (w != u);
+                    n_comps++; }
+                call_node.pop(); call_edge.pop();
+                if (call_node.size() > 0)
+                    low[call_node.last()] = min(low[call_node.last()], low[u]);
+            }
+        }
+    }
+
+    // Pick the representatives: frozen first, then the lowest variable (so the component of the
+    // negations gets the negated representative):
+    vec<Lit>    rep(n_comps, lit_Undef);
+    for (int i = 0; i < n; i++){
+        Lit     p = toLit(i);
+        int     c = comp[i];
+        if (c == -1) continue;
+        if (c == comp[index(~p)]){
+            ok = false;
+            return false; }
+        if (rep[c] == lit_Undef || (frozen[var(p)] && !frozen[var(rep[c])])
+         || (frozen[var(p)] == frozen[var(rep[c])] && var(p) < var(rep[c])))
+            rep[c] = p;
+    }
+    bool    changed = false;
+    for (Var v = 0; v < nVars(); v++){
+        int     c = comp[index(Lit(v))];
+        if (c == -1 || frozen[v] || var(rep[c]) == v) continue;
+        subst[v] = rep[c];
+        subst_order.push(v);
+        n_substituted++;
+        changed = true;
+    }
+    if (!changed) return false;
+
+    // Rewrite the clauses with the representatives:
+    vec<Lit>    ps;
+    int         n_clauses = clauses.size();
+    for (int i = 0; i < n_clauses && ok; i++){
+        if (clauses[i]->deleted) continue;
+        bool    touched = false;
+        ps.clear();
+        for (int j = 0; j < clauses[i]->lits.size(); j++){
+            Lit     p = clauses[i]->lits[j];
+            if (subst[var(p)] != lit_Undef){
+                p = sign(p) ? ~subst[var(p)] : subst[var(p)];
+                touched = true; }
+            ps.push(p);
+        }
+        if (touched){
+            removeClause(i);
+            attach(ps); }
+    }
+    return true;
+}
+
+
+// Check the clauses in 'subsumption_queue' against the clauses sharing their rarest variable:
+// remove the ones they subsume and strengthen the ones they subsume after flipping one literal.
+//
+void Simplifier::backwardSubsumption()
+{
+    vec<int>    cs;
+    while (ok && subsumption_head < subsumption_queue.size()){
+        propagate();
+        if (!ok) break;
+        int         ci = subsumption_queue[subsumption_head++];
+        SClause&    c  = *clauses[ci];
+        if (c.deleted) continue;
+
+        Lit     best = c.lits[0];
+        for (int i = 1; i < c.lits.size(); i++)
+            if (occurs[index(c.lits[i])].size() + occurs[index(~c.lits[i])].size()
+              < occurs[index(best)].size() + occurs[index(~best)].size())
+                best = c.lits[i];
+
+        for (int s = 0; s < 2 && !c.deleted; s++){
+            occurs[index(s ? ~best : best)].copyTo(cs);
+            for (int i = 0; i < cs.size() && !c.deleted && ok; i++){
+                SClause&    d = *clauses[cs[i]];
+                if (cs[i] == ci || d.deleted || d.lits.size() < c.lits.size() || (c.abst & ~d.abst) != 0)
+                    continue;
+                Lit     p = subsumes(c.lits, d.lits);
+                if (p == lit_Undef){
+                    removeClause(cs[i]);
+                    n_subsumed++;
+                }else if (p != lit_Error)
+                    strengthen(cs[i], ~p);
+            }
+        }
+    }
+    subsumption_queue.clear();
+    subsumption_head = 0;
+}
+
+
+// The resolvent of 'ps' and 'qs' on 'v' in 'out'. FALSE if it is a tautology.
+bool Simplifier::merge(const vec<Lit>& ps, const vec<Lit>& qs, Var v, vec<Lit>& out) const
+{
+    out.clear();
+    for (int i = 0; i < ps.size(); i++)
+        if (var(ps[i]) != v)
+            out.push(ps[i]);
+    int     size = out.size();
+    for (int j = 0; j < qs.size(); j++){
+        if (var(qs[j]) == v) continue;
+        int     i = 0;
+        for (; i < size; i++){
+            if (out[i] == ~qs[j]) return false;
+            if (out[i] == qs[j]) break; }
+        if (i == size)
+            out.push(qs[j]);
+    }
+    return true;
+}
+
+
+// Replace the clauses of 'v' by their resolvents, unless there would be more of them (or a too
+// long one). The removed clauses are kept in 'elimclauses' for 'extendModel()'.
+//
+bool Simplifier::eliminateVar(Var v)
+{
+    vec<int>    pos, neg;
+    occurs[index( Lit(v))].copyTo(pos);
+    occurs[index(~Lit(v))].copyTo(neg);
+    if (pos.size() > elim_occ_lim && neg.size() > elim_occ_lim)
+        return false;
+
+    vec<Lit>    resolvent;
+    int         cnt = 0;
+    for (int i = 0; i < pos.size(); i++)
+        for (int j = 0; j < neg.size(); j++)
+            if (merge(clauses[pos[i]]->lits, clauses[neg[j]]->lits, v, resolvent)
+             && (++cnt > pos.size() + neg.size() || resolvent.size() > elim_clause_lim))
+                return false;
+
+    // Keep the clauses of the smaller side, and a default value for 'v' satisfying the other:
+    vec<int>&   keep = pos.size() > neg.size() ? neg : pos;
+    for (int i = 0; i < keep.size(); i++){
+        const vec<Lit>& ps = clauses[keep[i]]->lits;
+        int     first = elimclauses.size();
+        for (int k = 0; k < ps.size(); k++){
+            elimclauses.push(index(ps[k]));
+            if (var(ps[k]) == v){
+                elimclauses[elimclauses.size()-1] = elimclauses[first];
+                elimclauses[first] = index(ps[k]); }
+        }
+        elimclauses.push(ps.size());
+    }
+    elimclauses.push(index(pos.size() > neg.size() ? Lit(v) : ~Lit(v)));
+    elimclauses.push(1);
+
+    vec<vec<Lit> >  resolvents;
+    for (int i = 0; i < pos.size(); i++)
+        for (int j = 0; j < neg.size(); j++)
+            if (merge(clauses[pos[i]]->lits, clauses[neg[j]]->lits, v, resolvent)){
+                resolvents.push();
+                resolvent.copyTo(resolvents.last()); }
+    for (int i = 0; i < pos.size(); i++) removeClause(pos[i]);
+    for (int i = 0; i < neg.size(); i++) removeClause(neg[i]);
+    for (int i = 0; i < resolvents.size(); i++)
+        attach(resolvents[i]);
+
+    eliminated[v] = 1;
+    n_eliminated++;
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  simplify : [void]  ->  [bool]
+|
+|  Description:
+|    Propagate the top-level units, substitute the equivalent literals, remove subsumed clauses,
+|    then eliminate the variables (cheapest first), checking the resolvents for subsumption as
+|    they come. Returns FALSE if the problem is found to be unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Simplifier::simplify()
+{
+    propagate();
+    for (int round = 0; ok && round < 3 && substituteEquivalences(); round++)
+        propagate();
+    backwardSubsumption();
+
+    vec<Var>    order;
+    vec<int>    cost(nVars(), 0);
+    for (Var v = 0; ok && v < nVars(); v++){
+        if (frozen[v] || assigns[v] != l_Undef || subst[v] != lit_Undef) continue;
+        cost[v] = occurs[index(Lit(v))].size() * occurs[index(~Lit(v))].size();
+        order.push(v);
+    }
+    struct CostLt {
+        const vec<int>& cost;
+        CostLt(const vec<int>& c) : cost(c) { }
+        bool operator () (Var x, Var y) const { return cost[x] < cost[y]; }
+    };
+    sort(order, CostLt(cost));
+    for (int i = 0; ok && i < order.size(); i++){
+        Var     v = order[i];
+        if (assigns[v] != l_Undef) continue;
+        if (eliminateVar(v))
+            backwardSubsumption();
+    }
+    return ok;
+}
+
+
+void Simplifier::copyTo(Solver& S) const
+{
+    assert(S.nVars() == 0);
+    while (S.nVars() < nVars())
+        S.newVar();
+    vec<Lit>    ps;
+    if (!ok){
+        S.addClause(ps);
+        return; }
+    for (int i = 0; i < units.size(); i++)
+        S.addUnit(units[i]);
+    for (int i = 0; i < clauses.size(); i++)
+        if (!clauses[i]->deleted)
+            S.addClause(clauses[i]->lits);
+}
+
+
+void Simplifier::extendModel(vec<lbool>& model) const
+{
+    // Eliminated variables, last first:
+    for (int i = elimclauses.size()-1, j; i > 0; i -= j){
+        for (j = elimclauses[i--]; j > 1; j--, i--){
+            Lit     p = toLit(elimclauses[i]);
+            if ((sign(p) ? ~model[var(p)] : model[var(p)]) != l_False)
+                goto next;
+        }
+        {   Lit     p = toLit(elimclauses[i]);
+            model[var(p)] = sign(p) ? l_False : l_True; }
+    next:;
+    }
+
+    // Substituted variables, last first (a representative may have been substituted later):
+    for (int i = subst_order.size()-1; i >= 0; i--){
+        Var     v = subst_order[i];
+        Lit     r = subst[v];
+        model[v] = sign(r) ? ~model[var(r)] : model[var(r)];
+    }
+}
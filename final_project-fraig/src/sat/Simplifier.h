@@ -0,0 +1,102 @@
+/************************************************************************************[Simplifier.h]
+MiniSat -- Copyright (c) 2003-2005, Niklas Een, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Simplifier_h
+#define Simplifier_h
+
+#include "Solver.h"
+
+
+//=================================================================================================
+// SatELite-style preprocessing of a CNF before a one-shot solve: top-level unit propagation,
+// equivalent literal substitution (strongly connected components of the binary clauses),
+// subsumption and self-subsuming resolution, and bounded variable elimination.
+//
+// Usage: add the problem ('newVar()', 'addClause()' -- or 'Solver::copyProblem()'), 'freeze()' the
+// variables which must survive as themselves, 'simplify()', give the result to an empty 'Solver'
+// with 'copyTo()', solve it, and complete its model with 'extendModel()'. The extended model
+// assigns every variable, eliminated or substituted ones included.
+
+
+class Simplifier {
+    struct SClause {
+        vec<Lit>    lits;       // Sorted.
+        uint64      abst;       // Bit (var % 64) set for every variable (for quick subset tests).
+        bool        deleted;
+    };
+
+    bool                ok;             // FALSE once the problem is known to be unsatisfiable.
+    vec<SClause*>       clauses;
+    vec<vec<int> >      occurs;         // 'occurs[index(p)]': the (live) clauses containing 'p'.
+    vec<lbool>          assigns;        // Top-level assignment.
+    vec<Lit>            units;          // Propagation queue of top-level assignments.
+    int                 units_head;
+    vec<int>            subsumption_queue;  // Clauses to check against the others (new or strengthened).
+    int                 subsumption_head;
+    vec<char>           frozen;
+    vec<char>           eliminated;
+    vec<Lit>            subst;          // 'subst[v]': the literal replacing 'v', or 'lit_Undef'.
+    vec<Var>            subst_order;    // Substituted variables, in order.
+    vec<uint>           elimclauses;    // Clauses of the eliminated variables: literals (pivot first), then the size.
+
+    // Clause database:
+    //
+    void    attach        (vec<Lit>& ps);       // Add a clause (simplified by the top-level assignment).
+    void    removeClause  (int ci);
+    void    strengthen    (int ci, Lit p);      // Remove 'p' from the clause.
+    void    enqueue       (Lit p);
+    void    propagate     ();
+    lbool   value         (Lit p) const { return sign(p) ? ~assigns[var(p)] : assigns[var(p)]; }
+
+    // Simplification steps:
+    //
+    bool    substituteEquivalences();
+    void    backwardSubsumption   ();
+    bool    eliminateVar          (Var v);
+    bool    merge                 (const vec<Lit>& ps, const vec<Lit>& qs, Var v, vec<Lit>& out) const;
+
+public:
+    Simplifier() : ok(true), units_head(0), subsumption_head(0)
+                 , elim_clause_lim(20), elim_occ_lim(10)
+                 , n_eliminated(0), n_substituted(0), n_subsumed(0), n_strengthened(0) { }
+   ~Simplifier();
+
+    Var     newVar     ();
+    int     nVars      () const { return assigns.size(); }
+    void    addClause  (const vec<Lit>& ps);
+    void    freeze     (Var v)  { frozen[v] = 1; }  // Never eliminate or substitute 'v'.
+    bool    okay       () const { return ok; }
+
+    bool    simplify   ();                          // FALSE if the problem is found unsatisfiable.
+    void    copyTo     (Solver& S) const;           // Give the simplified problem to the empty solver 'S'.
+    void    extendModel(vec<lbool>& model) const;   // Turn a model of the simplified problem into one of the original.
+
+    // Mode of operation:
+    //
+    int     elim_clause_lim;    // Don't eliminate a variable if it would produce a resolvent longer than this.
+    int     elim_occ_lim;       // Don't try to eliminate a variable with more occurrences than this of both signs.
+
+    // Statistics: (read-only member variables)
+    //
+    int     n_eliminated, n_substituted, n_subsumed, n_strengthened;
+};
+
+
+//=================================================================================================
+#endif
@@ -27,11 +27,25 @@ int effLimit = INT_MAX;
 // Helper functions:
 
 
-void removeWatch(vec<Clause*>& ws, Clause* elem)
+// The x-th element of the Luby sequence with base y: 1, 1, y, 1, 1, y, y^2, ...
+//
+static double luby(double y, int x)
+{
+    int size, seq;
+    for (size = 1, seq = 0; size < x+1; seq++, size = 2*size+1);
+    while (size-1 != x){
+        size = (size-1) >> 1;
+        seq--;
+        x = x % size; }
+    return pow(y, seq);
+}
+
+
+void removeWatch(vec<Watcher>& ws, CRef elem)
 {
     if (ws.size() == 0) return;     // (skip lists that are already cleared)
     int j = 0;
-    for (; ws[j] != elem  ; j++) assert(j < ws.size());
+    for (; ws[j].cref != elem; j++) assert(j < ws.size());
     for (; j < ws.size()-1; j++) ws[j] = ws[j+1];
     ws.pop();
 }
@@ -106,7 +120,8 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
 
     }else{
         // Allocate clause:
-        Clause* c   = Clause_new(learnt, ps, id);
+        CRef    cr  = ca.alloc(learnt, ps, id);
+        Clause& c   = ca[cr];
 
         if (learnt){
             // Put the second watch on the literal with highest decision level:
@@ -116,47 +131,50 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
                 if (level[var(ps[i])] > max)
                     max   = level[var(ps[i])],
                     max_i = i;
-            (*c)[1]     = ps[max_i];
-            (*c)[max_i] = ps[1];
+            c[1]     = ps[max_i];
+            c[max_i] = ps[1];
 
             // Bumping:
             claBumpActivity(c); // (newly learnt clauses should be considered active)
 
             // Enqueue asserting literal:
-            check(enqueue((*c)[0], c));
+            check(enqueue(c[0], cr));
 
             // Store clause:
-            watches[index(~(*c)[0])].push(c);
-            watches[index(~(*c)[1])].push(c);
-            learnts.push(c);
-            stats.learnts_literals += c->size();
+            vec<vec<Watcher> >& ws = c.size() == 2 ? watches_bin : watches;
+            ws[index(~c[0])].push(Watcher(cr, c[1]));
+            ws[index(~c[1])].push(Watcher(cr, c[0]));
+            learnts.push(cr);
+            stats.learnts_literals += c.size();
 
         }else{
             // Store clause:
-            watches[index(~(*c)[0])].push(c);
-            watches[index(~(*c)[1])].push(c);
-            clauses.push(c);
-            stats.clauses_literals += c->size();
+            vec<vec<Watcher> >& ws = c.size() == 2 ? watches_bin : watches;
+            ws[index(~c[0])].push(Watcher(cr, c[1]));
+            ws[index(~c[1])].push(Watcher(cr, c[0]));
+            clauses.push(cr);
+            stats.clauses_literals += c.size();
         }
     }
 }
 
 
 // Disposes a clauses and removes it from watcher lists. NOTE! Low-level; does NOT change the 'clauses' and 'learnts' vector.
+// The memory is only marked as wasted in 'ca' and reclaimed by 'garbageCollect()'.
 //
-void Solver::remove(Clause* c, bool just_dealloc)
+void Solver::remove(CRef cr)
 {
-    if (!just_dealloc){
-        removeWatch(watches[index(~(*c)[0])], c),
-        removeWatch(watches[index(~(*c)[1])], c);
+    Clause& c = ca[cr];
+    vec<vec<Watcher> >& ws = c.size() == 2 ? watches_bin : watches;
+    removeWatch(ws[index(~c[0])], cr),
+    removeWatch(ws[index(~c[1])], cr);
 
-        if (c->learnt()) stats.learnts_literals -= c->size();
-        else             stats.clauses_literals -= c->size();
+    if (c.learnt()) stats.learnts_literals -= c.size();
+    else            stats.clauses_literals -= c.size();
 
-        if (proof != NULL) proof->deleted(c->id());
-    }
+    if (proof != NULL) proof->deleted(c.id());
 
-    xfree(c);
+    ca.free(cr);
 }
 
 
@@ -164,11 +182,12 @@ void Solver::remove(Clause* c, bool just_dealloc)
 // the clause is binary and satisfied, in which case the first literal is true)
 // Returns True if clause is satisfied (will be removed), False otherwise.
 //
-bool Solver::simplify(Clause* c) const
+bool Solver::simplify(CRef cr) const
 {
     assert(decisionLevel() == 0);
-    for (int i = 0; i < c->size(); i++){
-        if (value((*c)[i]) == l_True)
+    const Clause& c = ca[cr];
+    for (int i = 0; i < c.size(); i++){
+        if (value(c[i]) == l_True)
             return true;
     }
     return false;
@@ -187,13 +206,17 @@ Var Solver::newVar() {
     index = nVars();
     watches     .push();          // (list for positive literal)
     watches     .push();          // (list for negative literal)
-    reason      .push(NULL);
+    watches_bin .push();
+    watches_bin .push();
+    reason      .push(CRef_Undef);
     assigns     .push(toInt(l_Undef));
     level       .push(-1);
     trail_pos   .push(-1);
     activity    .push(0);
     order       .newVar();
+    polarity    .push(1);
     analyze_seen.push(0);
+    lbd_stamp   .growTo(index+2, 0);  // (levels go from 0 to 'nVars()')
     if (proof != NULL) unit_id.push(ClauseId_NULL);
     return index; }
 
@@ -210,7 +233,8 @@ void Solver::cancelUntil(int level) {
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var     x  = var(trail[c]);
             assigns[x] = toInt(l_Undef);
-            reason [x] = NULL;
+            polarity[x] = sign(trail[c]);
+            reason [x] = CRef_Undef;
             order.undo(x); }
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
@@ -221,13 +245,30 @@ void Solver::cancelUntil(int level) {
 // Major methods:
 
 
+// Literal block distance: the number of distinct decision levels in 'c'.
+//
+template<class C>
+int Solver::computeLBD(const C& c)
+{
+    int     lbd = 0;
+    lbd_stamp_cur++;
+    for (int i = 0; i < c.size(); i++){
+        int l = level[var(c[i])];
+        if (lbd_stamp[l] != lbd_stamp_cur){
+            lbd_stamp[l] = lbd_stamp_cur;
+            lbd++; } }
+    return lbd;
+}
+
+
 /*_________________________________________________________________________________________________
 |
-|  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
+|  analyze : (confl : CRef) (out_learnt : vec<Lit>&) (out_btlevel : int&) (out_lbd : int&)  ->  [void]
 |  
 |  Description:
-|    Analyze conflict and produce a reason clause ('out_learnt') and a backtracking level
-|    ('out_btlevel').
+|    Analyze conflict and produce a reason clause ('out_learnt'), a backtracking level
+|    ('out_btlevel') and the literal block distance of the reason clause ('out_lbd'). The learnt
+|    clauses taking part are marked as used and their LBD is updated.
 |  
 |    Pre-conditions:
 |      * 'out_learnt' is assumed to be cleared.
@@ -244,7 +285,7 @@ public:
     lastToFirst_lt(const vec<int>& t) : trail_pos(t) {}
     bool operator () (Lit p, Lit q) { return trail_pos[var(p)] > trail_pos[var(q)]; }
 };
-void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
+void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_lbd)
 {
     vec<char>&     seen  = analyze_seen;
     int            pathC = 0;
@@ -252,16 +293,21 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
 
     // Generate conflict clause:
     //
-    if (proof != NULL) proof->beginChain(confl->id());
+    if (proof != NULL) proof->beginChain(ca[confl].id());
     out_learnt.push();          // (leave room for the asserting literal)
     out_btlevel = 0;
     int index = trail.size()-1;
     for(;;){
-        assert(confl != NULL);  // (otherwise should be UIP)
+        assert(confl != CRef_Undef);  // (otherwise should be UIP)
 
-        Clause& c = *confl;
-        if (c.learnt())
-            claBumpActivity(&c);
+        Clause& c = (p == lit_Undef) ? ca[confl] : reasonClause(var(p));
+        if (c.learnt()){
+            claBumpActivity(c);
+            c.setUsed(true);
+            if ((int)c.lbd() > core_lbd){
+                // (the LBD of a clause may drop as the search goes on)
+                int lbd = computeLBD(c);
+                if (lbd < (int)c.lbd()) c.setLbd(lbd); } }
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
             Lit q = c[j];
@@ -288,7 +334,7 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
         pathC--;
         if (pathC == 0) break;
 
-        if (proof != NULL) proof->resolve(confl->id(), ~p);
+        if (proof != NULL) proof->resolve(ca[confl].id(), ~p);
     }
     out_learnt[0] = ~p;
 
@@ -304,18 +350,18 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
 
         analyze_toclear.clear();
         for (i = j = 1; i < out_learnt.size(); i++)
-            if (reason[var(out_learnt[i])] == NULL || !analyze_removable(out_learnt[i], min_level))
+            if (reason[var(out_learnt[i])] == CRef_Undef || !analyze_removable(out_learnt[i], min_level))
                 out_learnt[j++] = out_learnt[i];
     }else if(expensive_ccmin == 1){
         // Simplify conflict clause (a little):
         //
         analyze_toclear.clear();
         for (i = j = 1; i < out_learnt.size(); i++){
-            Clause* r = reason[var(out_learnt[i])];
-            if (r == NULL)
+            CRef r = reason[var(out_learnt[i])];
+            if (r == CRef_Undef)
                 out_learnt[j++] = out_learnt[i];
             else{
-                Clause& c = *r;
+                Clause& c = reasonClause(var(out_learnt[i]));
                 for (int k = 1; k < c.size(); k++)
                     if (!seen[var(c[k])] && level[var(c[k])] != 0){
                         out_learnt[j++] = out_learnt[i];
@@ -334,7 +380,7 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
         for (int k = 0; k < analyze_toclear.size(); k++){
             Var     v = var(analyze_toclear[k]); assert(level[v] > 0);
 				Lit     l = analyze_toclear[k];
-            Clause& c = *reason[v];
+            Clause& c = reasonClause(v);
             proof->resolve(c.id(), l);
             for (int k = 1; k < c.size(); k++)
                 if (level[var(c[k])] == 0)
@@ -350,6 +396,7 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
     stats.max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
     stats.tot_literals += out_learnt.size();
+    out_lbd = computeLBD(out_learnt);
 }
 
 
@@ -357,17 +404,17 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
 //
 bool Solver::analyze_removable(Lit p, uint min_level)
 {
-    assert(reason[var(p)] != NULL);
+    assert(reason[var(p)] != CRef_Undef);
     analyze_stack.clear(); analyze_stack.push(p);
     int top = analyze_toclear.size();
     while (analyze_stack.size() > 0){
-        assert(reason[var(analyze_stack.last())] != NULL);
-        Clause& c = *reason[var(analyze_stack.last())];
+        assert(reason[var(analyze_stack.last())] != CRef_Undef);
+        Clause& c = reasonClause(var(analyze_stack.last()));
         analyze_stack.pop();
         for (int i = 1; i < c.size(); i++){
             Lit p = c[i];
             if (!analyze_seen[var(p)] && level[var(p)] != 0){
-                if (reason[var(p)] != NULL && ((1 << (level[var(p)] & 31)) & min_level) != 0){
+                if (reason[var(p)] != CRef_Undef && ((1 << (level[var(p)] & 31)) & min_level) != 0){
                     analyze_seen[var(p)] = 1;
                     analyze_stack.push(p);
                     analyze_toclear.push(p);
@@ -388,7 +435,7 @@ bool Solver::analyze_removable(Lit p, uint min_level)
 
 /*_________________________________________________________________________________________________
 |
-|  analyzeFinal : (confl : Clause*) (skip_first : bool)  ->  [void]
+|  analyzeFinal : (confl : CRef) (skip_first : bool)  ->  [void]
 |  
 |  Description:
 |    Specialized analysis procedure to express the final conflict in terms of assumptions.
@@ -396,7 +443,7 @@ bool Solver::analyze_removable(Lit p, uint min_level)
 |    making assumptions). If 'skip_first' is TRUE, the first literal of 'confl' is  ignored (needed
 |    if conflict arose before search even started).
 |________________________________________________________________________________________________@*/
-void Solver::analyzeFinal(Clause* confl, bool skip_first)
+void Solver::analyzeFinal(CRef confl, bool skip_first)
 {
     // -- NOTE! This code is relatively untested. Please report bugs!
     conflict.clear();
@@ -405,10 +452,11 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
         return; }
    //assert(false);
     vec<char>&     seen  = analyze_seen;
-    if (proof != NULL) proof->beginChain(confl->id());
-    for (int i = skip_first ? 1 : 0; i < confl->size(); i++){
-        Var     x = var((*confl)[i]);
-		  Lit		 l = (*confl)[i];
+    Clause& cc = ca[confl];
+    if (proof != NULL) proof->beginChain(cc.id());
+    for (int i = skip_first ? 1 : 0; i < cc.size(); i++){
+        Var     x = var(cc[i]);
+		  Lit		 l = cc[i];
         if (level[x] > 0)
             seen[x] = 1;
         else
@@ -420,12 +468,12 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
         Var     x = var(trail[i]);
 		  Lit     l = trail[i];
         if (seen[x]){
-            Clause* r = reason[x];
-            if (r == NULL){
+            CRef r = reason[x];
+            if (r == CRef_Undef){
                 assert(level[x] > 0);
                 conflict.push(~trail[i]);
             }else{
-                Clause& c = *r;
+                Clause& c = reasonClause(x);
                 if (proof != NULL) proof->resolve(c.id(), l);
                 for (int j = 1; j < c.size(); j++)
                     if (level[var(c[j])] > 0)
@@ -442,7 +490,7 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
 
 /*_________________________________________________________________________________________________
 |
-|  enqueue : (p : Lit) (from : Clause*)  ->  [bool]
+|  enqueue : (p : Lit) (from : CRef)  ->  [bool]
 |  
 |  Description:
 |    Puts a new fact on the propagation queue as well as immediately updating the variable's value.
@@ -451,12 +499,12 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
 |  Input:
 |    p    - The fact to enqueue
 |    from - [Optional] Fact propagated from this (currently) unit clause. Stored in 'reason[]'.
-|           Default value is NULL (no reason).
+|           Default value is CRef_Undef (no reason).
 |  
 |  Output:
 |    TRUE if fact was enqueued without conflict, FALSE otherwise.
 |________________________________________________________________________________________________@*/
-bool Solver::enqueue(Lit p, Clause* from)
+bool Solver::enqueue(Lit p, CRef from)
 {
     if (value(p) != l_Undef)
         return value(p) != l_False;
@@ -475,30 +523,54 @@ bool Solver::enqueue(Lit p, Clause* from)
 
 /*_________________________________________________________________________________________________
 |
-|  propagate : [void]  ->  [Clause*]
+|  propagate : [void]  ->  [CRef]
 |  
 |  Description:
 |    Propagates all enqueued facts. If a conflict arises, the conflicting clause is returned,
-|    otherwise NULL. NOTE! This method has been optimized for speed rather than readability.
+|    otherwise CRef_Undef. NOTE! This method has been optimized for speed rather than readability.
 |  
 |    Post-conditions:
 |      * The propagation queue is empty, even if there was a conflict.
 |________________________________________________________________________________________________@*/
-Clause* Solver::propagate()
+CRef Solver::propagate()
 {
-    Clause* confl = NULL;
+    CRef    confl = CRef_Undef;
     while (qhead < trail.size()){
         stats.propagations++;
         simpDB_props--;
 
         Lit            p  = trail[qhead++];     // 'p' is enqueued fact to propagate.
-        vec<Clause*>&  ws = watches[index(p)];
-        Clause**       i,** j,** end;
+        Lit            false_lit = ~p;
+
+        // Binary clauses first; the clause itself is only read for proof logging:
+        vec<Watcher>&  wbin = watches_bin[index(p)];
+        for (int k = 0; k < wbin.size(); k++){
+            Lit first = wbin[k].blocker;
+            if (value(first) == l_True) continue;
+            if (decisionLevel() == 0 && proof != NULL){
+                Clause& c = ca[wbin[k].cref];
+                if (c[0] != first) c[1] = c[0], c[0] = first;
+                proofUnit(c); }
+            if (!enqueue(first, wbin[k].cref)){
+                if (decisionLevel() == 0)
+                    ok = false;
+                confl = wbin[k].cref;
+                qhead = trail.size();
+                break; }
+        }
+        if (confl != CRef_Undef) break;
 
-        for (i = j = (Clause**)ws, end = i + ws.size();  i != end;){
-            Clause& c = **i; i++;
+        vec<Watcher>&  ws = watches[index(p)];
+        Watcher       *i, *j, *end;
+
+        for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
+            // If the blocker is true, the clause is already satisfied:
+            if (value(i->blocker) == l_True){
+                *j++ = *i++; continue; }
+
+            CRef    cr = i->cref; i++;
+            Clause& c  = ca[cr];
             // Make sure the false literal is data[1]:
-            Lit false_lit = ~p;
             if (c[0] == false_lit)
                 c[0] = c[1], c[1] = false_lit;
 
@@ -508,38 +580,24 @@ Clause* Solver::propagate()
             Lit   first = c[0];
             lbool val   = value(first);
             if (val == l_True){
-                *j++ = &c;
+                *j++ = Watcher(cr, first);
             }else{
                 // Look for new watch:
                 for (int k = 2; k < c.size(); k++)
                     if (value(c[k]) != l_False){
                         c[1] = c[k]; c[k] = false_lit;
-                        watches[index(~c[1])].push(&c);
+                        watches[index(~c[1])].push(Watcher(cr, first));
                         goto FoundWatch; }
 
                 // Did not find watch -- clause is unit under assignment:
-                if (decisionLevel() == 0 && proof != NULL){
-                    // Log the production of this unit clause:
-                    proof->beginChain(c.id());
-                    for (int k = 1; k < c.size(); k++)
-                        proof->resolve(unit_id[var(c[k])], c[k]);
-                    ClauseId id = proof->endChain();
-                    assert(unit_id[var(first)] == ClauseId_NULL || value(first) == l_False);    // (if variable already has 'id', it must be with the other polarity and we should have derived the empty clause here)
-                    if (value(first) != l_False)
-                        unit_id[var(first)] = id;
-                    else{
-                        // Empty clause derived:
-                        proof->beginChain(unit_id[var(first)]);
-                        proof->resolve(id, ~first);
-                        proof->endChain();
-                    }
-                }
-					 
-                *j++ = &c;
-                if (!enqueue(first, &c)){
+                if (decisionLevel() == 0 && proof != NULL)
+                    proofUnit(c);
+
+                *j++ = Watcher(cr, first);
+                if (!enqueue(first, cr)){
                     if (decisionLevel() == 0)
                         ok = false;
-                    confl = &c;
+                    confl = cr;
                     qhead = trail.size();
                     // Copy the remaining watches:
                     while (i < end)
@@ -555,34 +613,120 @@ Clause* Solver::propagate()
 }
 
 
+// Log the production of the unit clause 'c[0]' (all the other literals are false at top-level).
+//
+void Solver::proofUnit(const Clause& c)
+{
+    Lit first = c[0];
+    proof->beginChain(c.id());
+    for (int k = 1; k < c.size(); k++)
+        proof->resolve(unit_id[var(c[k])], c[k]);
+    ClauseId id = proof->endChain();
+    assert(unit_id[var(first)] == ClauseId_NULL || value(first) == l_False);    // (if variable already has 'id', it must be with the other polarity and we should have derived the empty clause here)
+    if (value(first) != l_False)
+        unit_id[var(first)] = id;
+    else{
+        // Empty clause derived:
+        proof->beginChain(unit_id[var(first)]);
+        proof->resolve(id, ~first);
+        proof->endChain();
+    }
+}
+
+
+// Binary clauses are propagated without reordering their literals, so the implied literal may be
+// 'c[1]'. Everything reading a reason clause expects it at 'c[0]'.
+//
+Clause& Solver::reasonClause(Var x)
+{
+    Clause& c = ca[reason[x]];
+    if (c.size() == 2 && var(c[0]) != x){
+        Lit tmp = c[0]; c[0] = c[1]; c[1] = tmp; }
+    return c;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  reduceDB : ()  ->  [void]
 |  
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
-|    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|    clauses are clauses that are reason to some assignment. Binary clauses and clauses with LBD <=
+|    'core_lbd' are never removed. Clauses with LBD <= 'tier2_lbd' are kept if they were used in a
+|    conflict since the last call; the others (and unused tier-2 clauses) are aged out by activity.
 |________________________________________________________________________________________________@*/
-struct reduceDB_lt { bool operator () (Clause* x, Clause* y) { return x->size() > 2 && (y->size() == 2 || x->activity() < y->activity()); } };
+struct reduceDB_lt {
+    const ClauseAllocator& ca;
+    reduceDB_lt(const ClauseAllocator& ca_) : ca(ca_) { }
+    bool operator () (CRef x, CRef y) { return ca[x].activity() < ca[y].activity(); } };
 void Solver::reduceDB()
 {
     int     i, j;
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
-    sort(learnts, reduceDB_lt());
-    for (i = j = 0; i < learnts.size() / 2; i++){
-        if (learnts[i]->size() > 2 && !locked(learnts[i]))
-            remove(learnts[i]);
+    // Keep the core (binary or LBD <= 'core_lbd') and the used tier-2 clauses, the rest compete by activity:
+    vec<CRef>       local;
+    learnts_core = 0;
+    for (i = j = 0; i < learnts.size(); i++){
+        Clause& c = ca[learnts[i]];
+        if (c.size() == 2 || (int)c.lbd() <= core_lbd)
+            learnts[j++] = learnts[i], learnts_core++;
+        else if ((int)c.lbd() <= tier2_lbd && c.used())
+            c.setUsed(false), learnts[j++] = learnts[i];
+        else
+            local.push(learnts[i]);
+    }
+    learnts.shrink(i - j);
+
+    sort(local, reduceDB_lt(ca));
+    for (i = 0; i < local.size() / 2; i++){
+        if (!locked(local[i]))
+            remove(local[i]);
         else
-            learnts[j++] = learnts[i];
+            learnts.push(local[i]);
     }
-    for (; i < learnts.size(); i++){
-        if (learnts[i]->size() > 2 && !locked(learnts[i]) && learnts[i]->activity() < extra_lim)
-            remove(learnts[i]);
+    for (; i < local.size(); i++){
+        if (!locked(local[i]) && ca[local[i]].activity() < extra_lim)
+            remove(local[i]);
         else
-            learnts[j++] = learnts[i];
+            learnts.push(local[i]);
     }
-    learnts.shrink(i - j);
+    checkGarbage();
+}
+
+
+// Compact the clause arena once 'garbage_frac' of it is taken by removed clauses.
+//
+void Solver::checkGarbage()
+{
+    if (ca.wasted() > ca.size() * garbage_frac)
+        garbageCollect();
+}
+
+
+// Move every live clause into a new arena and update all the references: watches, reasons and
+// the clause lists. A clause is copied once, later references follow its relocation.
+//
+void Solver::garbageCollect()
+{
+    ClauseAllocator to(ca.size() - ca.wasted());
+
+    for (int i = 0; i < watches.size(); i++){
+        for (int j = 0; j < watches[i].size(); j++)
+            ca.reloc(watches[i][j].cref, to);
+        for (int j = 0; j < watches_bin[i].size(); j++)
+            ca.reloc(watches_bin[i][j].cref, to); }
+    for (int i = 0; i < trail.size(); i++){
+        Var x = var(trail[i]);
+        if (reason[x] != CRef_Undef)
+            ca.reloc(reason[x], to); }
+    for (int i = 0; i < learnts.size(); i++)
+        ca.reloc(learnts[i], to);
+    for (int i = 0; i < clauses.size(); i++)
+        ca.reloc(clauses[i], to);
+
+    to.moveTo(ca);
 }
 
 
@@ -599,7 +743,7 @@ void Solver::simplifyDB()
     if (!ok) return;    // GUARD (public method)
     assert(decisionLevel() == 0);
 
-    if (propagate() != NULL){
+    if (propagate() != CRef_Undef){
         ok = false;
         return; }
 
@@ -611,11 +755,13 @@ void Solver::simplifyDB()
         Lit p = trail[i];
         watches[index( p)].clear(true);
         watches[index(~p)].clear(true);
+        watches_bin[index( p)].clear(true);
+        watches_bin[index(~p)].clear(true);
     }
 
     // Remove satisfied clauses:
     for (int type = 0; type < 2; type++){
-        vec<Clause*>& cs = type ? learnts : clauses;
+        vec<CRef>&    cs = type ? learnts : clauses;
         int           j  = 0;
         for (int i = 0; i < cs.size(); i++){
             if (!locked(cs[i]) && simplify(cs[i]))
@@ -625,12 +771,30 @@ void Solver::simplifyDB()
         }
         cs.shrink(cs.size()-j);
     }
+    checkGarbage();
 
     simpDB_assigns = nAssigns();
     simpDB_props   = stats.clauses_literals + stats.learnts_literals;   // (shouldn't depend on 'stats' really, but it will do for now)
 }
 
 
+// Push 'lbd' into the window of recent conflicts. A restart is due if the recent conflicts are
+// (by a margin of 'restart_K') worse than the average of all conflicts so far.
+//
+bool Solver::glucoseRestart(int lbd, const SearchParams& params)
+{
+    if (lbd_queue.size() < params.restart_window)
+        lbd_queue.push(lbd);
+    else{
+        lbd_queue_sum -= lbd_queue[lbd_queue_head];
+        lbd_queue[lbd_queue_head] = lbd;
+        lbd_queue_head = (lbd_queue_head + 1) % params.restart_window; }
+    lbd_queue_sum += lbd;
+    return lbd_queue.size() == params.restart_window
+        && params.restart_K * lbd_queue_sum / params.restart_window > (double)lbd_sum / stats.conflicts;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  search : (nof_conflicts : int) (nof_learnts : int) (params : const SearchParams&)  ->  [lbool]
@@ -652,13 +816,22 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
 
     stats.starts++;
     int     conflictC = 0;
-    var_decay = 1 / params.var_decay;
+    bool    restart   = false;
+    if (params.var_decay < 0)
+        var_decay = 1 / params.var_decay;
+    else{
+        if (var_decay_cur < 0 || var_decay_cur > params.var_decay)
+            var_decay_cur = min(params.var_decay_start, params.var_decay);
+        var_decay = 1 / var_decay_cur; }
     cla_decay = 1 / params.clause_decay;
     model.clear();
+    lbd_queue.clear(); lbd_queue_head = 0; lbd_queue_sum = 0;
+    if (portfolio != NULL && proof == NULL)
+        importShared();
 
     for (;;){
-        Clause* confl = propagate();
-        if (confl != NULL){
+        CRef confl = propagate();
+        if (confl != CRef_Undef){
             // CONFLICT
 
             stats.conflicts++; conflictC++;
@@ -668,18 +841,28 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 // Contradiction found:
                 analyzeFinal(confl);
                 return l_False; }
-            analyze(confl, learnt_clause, backtrack_level);
+            int         lbd;
+            analyze(confl, learnt_clause, backtrack_level, lbd);
+            lbd_sum += lbd;
+            if (params.restart == restart_Glucose && glucoseRestart(lbd, params))
+                restart = true;
             cancelUntil(max(backtrack_level, root_level));
             newClause(learnt_clause, true, (proof != NULL) ? proof->last() : ClauseId_NULL);
+            if (learnt_clause.size() > 1) ca[learnts.last()].setLbd(lbd);
+            if (portfolio != NULL && learnt_clause.size() <= Portfolio::max_size)
+                portfolio->put(portfolio_id, learnt_clause);
             if (learnt_clause.size() == 1) level[var(learnt_clause[0])] = 0;    // (this is ugly (but needed for 'analyzeFinal()') -- in future versions, we will backtrack past the 'root_level' and redo the assumptions)
+            if (var_decay_cur >= 0 && var_decay_cur < params.var_decay && stats.conflicts % 5000 == 0){
+                var_decay_cur = min(var_decay_cur + 0.01, params.var_decay);
+                var_decay     = 1 / var_decay_cur; }
             varDecayActivity();
             claDecayActivity();
 
         }else{
             // NO CONFLICT
 
-            if (nof_conflicts >= 0 && conflictC >= nof_conflicts){
-                // Reached bound on number of conflicts:
+            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || restart || !withinBudget()){
+                // Reached bound on number of conflicts (or the budget of 'solveLimited()' ran out):
                 progress_estimate = progressEstimate();
                 cancelUntil(root_level);
                 return l_Undef; }
@@ -688,7 +871,7 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 // Simplify the set of problem clauses:
                 simplifyDB(), assert(ok);
 
-            if (nof_learnts >= 0 && learnts.size()-nAssigns() >= nof_learnts)
+            if (nof_learnts >= 0 && learnts.size()-learnts_core-nAssigns() >= nof_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
 
@@ -704,7 +887,72 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 return l_True;
             }
 
-            check(assume(~Lit(next)));
+            check(assume(params.phase_saving && !polarity[next] ? Lit(next) : ~Lit(next)));
+        }
+    }
+}
+
+
+// Returns FALSE if the conflict or propagation budget set for 'solveLimited()' is exhausted.
+//
+bool Solver::withinBudget() const
+{
+    return (conflict_budget    < 0 || stats.conflicts    < conflict_budget)
+        && (propagation_budget < 0 || stats.propagations < propagation_budget)
+        && (portfolio == NULL || !portfolio->stopped());
+}
+
+
+// Add the clauses published by the other solvers of the portfolio. They follow from the same
+// problem clauses, so they are kept just like our own learnt clauses (but not with proof logging,
+// as their derivation is unknown). Called at 'root_level', before searching.
+//
+void Solver::importShared()
+{
+    assert(decisionLevel() == root_level);
+    vec<Lit>&   tmp = importShared_tmp;
+    vec<Lit>    ps;
+    tmp.clear();
+    portfolio->get(portfolio_id, tmp);
+    for (int i = 0; i < tmp.size(); i++){
+        // Drop the literals assigned at the top-level (or the whole clause if one is true):
+        bool    satisfied = false;
+        ps.clear();
+        for (; tmp[i] != lit_Undef; i++){
+            if (value(tmp[i]) == l_Undef || level[var(tmp[i])] != 0)
+                ps.push(tmp[i]);
+            else if (value(tmp[i]) == l_True)
+                satisfied = true;
+        }
+        if (satisfied || ps.size() == 0) continue;
+
+        // Watch the non-false literals, or else the false ones of the highest level:
+        for (int k = 0; k < 2 && k < ps.size(); k++){
+            int     best = k;
+            for (int j = k+1; j < ps.size(); j++){
+                if (value(ps[best]) != l_False) break;
+                if (value(ps[j]) != l_False || level[var(ps[j])] > level[var(ps[best])])
+                    best = j; }
+            Lit     tmp_lit = ps[k]; ps[k] = ps[best]; ps[best] = tmp_lit;
+        }
+        if (value(ps[0]) == l_False)
+            continue;   // (conflicts with the assumptions -- 'search()' will find out by itself)
+
+        if (ps.size() == 1){
+            check(enqueue(ps[0]));
+            level[var(ps[0])] = 0;  // (same as a learnt unit in 'search()')
+        }else{
+            CRef    cr = ca.alloc(true, ps);
+            Clause& c  = ca[cr];
+            c.setLbd(c.size());
+            claBumpActivity(c);
+            vec<vec<Watcher> >& ws = c.size() == 2 ? watches_bin : watches;
+            ws[index(~c[0])].push(Watcher(cr, c[1]));
+            ws[index(~c[1])].push(Watcher(cr, c[0]));
+            learnts.push(cr);
+            stats.learnts_literals += c.size();
+            if (value(c[0]) == l_Undef && value(c[1]) == l_False)
+                check(enqueue(c[0], cr));
         }
     }
 }
@@ -738,7 +986,7 @@ void Solver::varRescaleActivity()
 void Solver::claRescaleActivity()
 {
     for (int i = 0; i < learnts.size(); i++)
-        learnts[i]->activity() *= 1e-20;
+        ca[learnts[i]].activity() *= 1e-20;
     cla_inc *= 1e-20;
 }
 
@@ -757,12 +1005,31 @@ void Solver::claRescaleActivity()
 |    not contain both 'x' and '~x' for any variable 'x'.
 |________________________________________________________________________________________________@*/
 bool Solver::solve(const vec<Lit>& assumps)
+{
+    budgetOff();
+    return solveLimited(assumps) == l_True;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  solveLimited : (assumps : const vec<Lit>&)  ->  [lbool]
+|  
+|  Description:
+|    Same as 'solve()', but gives up as soon as 'conflict_budget' or 'propagation_budget' is
+|    exceeded. Set the budgets with 'setConfBudget()'/'setPropBudget()' before calling.
+|  
+|  Output:
+|    'l_True' if satisfiable, 'l_False' if unsatisfiable, 'l_Undef' if the budget ran out.
+|________________________________________________________________________________________________@*/
+lbool Solver::solveLimited(const vec<Lit>& assumps)
 {
     simplifyDB();
-    if (!ok) return false;
+    if (!ok) return l_False;
 
     SearchParams    params(default_params);
-    double  nof_conflicts = 100;
+    double  nof_conflicts = params.restart_first;
+    int     nof_restarts  = 0;
     double  nof_learnts   = nClauses() / 3;
     lbool   status        = l_Undef;
 
@@ -772,7 +1039,8 @@ bool Solver::solve(const vec<Lit>& assumps)
         Lit p = assumps[i];
         assert(var(p) < nVars());
         if (!assume(p)){
-            if (reason[var(p)] != NULL){
+            if (reason[var(p)] != CRef_Undef){
+                reasonClause(var(p));   // (so that the literal skipped by 'analyzeFinal()' is '~p')
                 analyzeFinal(reason[var(p)], true);
                 conflict.push(~p);
             }else{
@@ -782,12 +1050,12 @@ bool Solver::solve(const vec<Lit>& assumps)
                 if (proof != NULL) conflict_id = unit_id[var(p)];
             }
             cancelUntil(0);
-            return false; }
-        Clause* confl = propagate();
-        if (confl != NULL){
+            return l_False; }
+        CRef confl = propagate();
+        if (confl != CRef_Undef){
             analyzeFinal(confl), assert(conflict.size() > 0);
             cancelUntil(0);
-            return false; }
+            return l_False; }
     }
     assert(root_level == decisionLevel());
 
@@ -803,7 +1071,7 @@ bool Solver::solve(const vec<Lit>& assumps)
         reportf("===================================\n");
     }
 
-    while (status == l_Undef){
+    while (status == l_Undef && withinBudget()){
         if (verbosity >= 1){
             printStats();
             reportf("| %9d | %7d %8d | %7d %7d %8d %7.1f | %6.3f %% |\n",
@@ -815,13 +1083,19 @@ bool Solver::solve(const vec<Lit>& assumps)
                    progress_estimate*100);
             fflush(stdout);
         }
+        if (params.restart == restart_Luby)
+            nof_conflicts = params.restart_first * luby(params.restart_inc, nof_restarts);
+        else if (params.restart == restart_Glucose)
+            nof_conflicts = -1;
         status = search((int)nof_conflicts, (int)nof_learnts, params);
-        nof_conflicts *= 1.5;
+        if (params.restart == restart_Geometric)
+            nof_conflicts *= params.restart_inc;
         nof_learnts   *= 1.1;
+        nof_restarts++;
 
 if ((int)stats.conflicts >= effLimit) {
    cancelUntil(0);
-   return status == l_True;
+   return status;
 }
     }
     if (verbosity >= 1) {
@@ -830,7 +1104,7 @@ if ((int)stats.conflicts >= effLimit) {
     }
 
     cancelUntil(0);
-    return status == l_True;
+    return status;
 }
 
 void Solver::printStats()
@@ -850,3 +1124,32 @@ void Solver::printStats()
     reportf("=======================================");
     reportf("===============================\n");
 }
+
+
+/*_________________________________________________________________________________________________
+|
+|  toDimacs : (out : FILE*) (assumps : const vec<Lit>&)  ->  [void]
+|  
+|  Description:
+|    Write the problem clauses in DIMACS CNF. Top-level assignments and the assumptions are written
+|    as unit clauses, so solving the file answers 'solve(assumps)'. Learnt clauses are implied by
+|    the others and left out. Must be called at decision level 0 (i.e. outside of 'solve()').
+|________________________________________________________________________________________________@*/
+void Solver::toDimacs(FILE* out, const vec<Lit>& assumps)
+{
+    assert(decisionLevel() == 0);
+    if (!ok){
+        fprintf(out, "p cnf %d 1\n0\n", nVars());
+        return; }
+
+    fprintf(out, "p cnf %d %d\n", nVars(), clauses.size() + trail.size() + assumps.size());
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        for (int j = 0; j < c.size(); j++)
+            fprintf(out, "%d ", ::toDimacs(c[j]));
+        fprintf(out, "0\n"); }
+    for (int i = 0; i < trail.size(); i++)
+        fprintf(out, "%d 0\n", ::toDimacs(trail[i]));
+    for (int i = 0; i < assumps.size(); i++)
+        fprintf(out, "%d 0\n", ::toDimacs(assumps[i]));
+}
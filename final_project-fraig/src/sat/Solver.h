@@ -23,6 +23,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "SolverTypes.h"
 #include "VarOrder.h"
 #include "Proof.h"
+#include "Portfolio.h"
 
 // Redfine if you want output to go somewhere else:
 #define reportf(format, args...) ( printf(format , ## args), fflush(stdout) )
@@ -32,6 +33,16 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 // Solver -- the main class:
 
 
+// An entry of a watch list: the watched clause and a literal of it ('blocker'). If the blocker is
+// true, the clause is satisfied and 'propagate()' skips it without reading the clause. For binary
+// clauses the blocker is the other literal, so the clause is never read at all.
+struct Watcher {
+    CRef    cref;
+    Lit     blocker;
+    Watcher(CRef cr = CRef_Undef, Lit p = lit_Undef) : cref(cr), blocker(p) { }
+};
+
+
 struct SolverStats {
     int64   starts, decisions, propagations, conflicts;
     int64   clauses_literals, learnts_literals, max_literals, tot_literals;
@@ -40,9 +51,23 @@ struct SolverStats {
 };
 
 
+enum RestartType {
+    restart_Geometric,  // 'restart_first * restart_inc^i' conflicts (the original MiniSat 1.x behavior)
+    restart_Luby,       // 'restart_first * luby(restart_inc, i)' conflicts
+    restart_Glucose     // Restart when the recent LBDs are worse than the average (see 'restart_K')
+};
+
 struct SearchParams {
-    double  var_decay, clause_decay, random_var_freq;    // (reasonable values are: 0.95, 0.999, 0.02)    
-    SearchParams(double v = 1, double c = 1, double r = 0) : var_decay(v), clause_decay(c), random_var_freq(r) { }
+    double      var_decay, clause_decay, random_var_freq;    // (reasonable values are: 0.95, 0.999, 0.02)    
+    RestartType restart;
+    double      restart_first, restart_inc;     // Geometric/Luby: (reasonable values are: 100, 1.5 / 100, 2)
+    double      restart_K;                      // Glucose: restart if K * (average LBD of the last 'restart_window' conflicts) > (average LBD)
+    int         restart_window;                 //          (reasonable values are: 0.8, 50)
+    bool        phase_saving;                   // Branch on the last value of a variable instead of always 'false'.
+    double      var_decay_start;                // EVSIDS: start from this decay and raise it by 0.01 every 5000 conflicts up to 'var_decay'.
+    SearchParams(double v = 1, double c = 1, double r = 0, RestartType rt = restart_Geometric, double rf = 100, double ri = 1.5, bool ps = false)
+        : var_decay(v), clause_decay(c), random_var_freq(r), restart(rt), restart_first(rf), restart_inc(ri)
+        , restart_K(0.8), restart_window(50), phase_saving(ps), var_decay_start(v) { }
 };
 
 
@@ -51,8 +76,9 @@ protected:
     // Solver state:
     //
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
-    vec<Clause*>        clauses;          // List of problem clauses.
-    vec<Clause*>        learnts;          // List of learnt clauses.
+    ClauseAllocator     ca;               // Memory of all the clauses; everything else refers to them by 'CRef'.
+    vec<CRef>           clauses;          // List of problem clauses.
+    vec<CRef>           learnts;          // List of learnt clauses.
     vec<ClauseId>       unit_id;          // 'unit_id[var]' is the clause ID for the unit literal 'var' or '~var' (if set at toplevel).
     double              cla_inc;          // Amount to bump next clause with.
     double              cla_decay;        // INVERSE decay factor for clause activity: stores 1/decay.
@@ -60,30 +86,39 @@ protected:
     vec<double>         activity;         // A heuristic measurement of the activity of a variable.
     double              var_inc;          // Amount to bump next variable with.
     double              var_decay;        // INVERSE decay factor for variable activity: stores 1/decay. Use negative value for static variable order.
+    double              var_decay_cur;    // Current (non-inverse) decay while ramping up to 'SearchParams::var_decay'. Negative if not started.
     VarOrder            order;            // Keeps track of the decision variable order.
+    vec<char>           polarity;         // The sign of the last value of each variable (for phase saving).
 
-    vec<vec<Clause*> >  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    vec<vec<Watcher> >  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    vec<vec<Watcher> >  watches_bin;      // Same as 'watches' for binary clauses only. Their literals are never reordered by 'propagate()'.
     vec<char>           assigns;          // The current assignments (lbool:s stored as char:s).
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail[]'.
-    vec<Clause*>        reason;           // 'reason[var]' is the clause that implied the variables current value, or 'NULL' if none.
+    vec<CRef>           reason;           // 'reason[var]' is the clause that implied the variables current value, or 'CRef_Undef' if none.
     vec<int>            level;            // 'level[var]' is the decision level at which assignment was made.
     vec<int>            trail_pos;        // 'trail_pos[var]' is the variable's position in 'trail[]'. This supersedes 'level[]' in some sense, and 'level[]' will probably be removed in future releases.
     int                 root_level;       // Level of first proper decision.
     int                 qhead;            // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplifyDB()'.
     int64               simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplifyDB()'.
+    vec<int>            lbd_queue;        // LBDs of the last conflicts (ring buffer for glucose restarts).
+    int                 lbd_queue_head;   // Next position to overwrite in 'lbd_queue'.
+    int64               lbd_queue_sum;    // Sum of 'lbd_queue'.
+    int64               lbd_sum;          // Sum of the LBDs of all the conflicts.
+    int                 learnts_core;     // Number of learnt clauses kept forever by the last 'reduceDB()' (not counted against the limit).
 
     // Temporaries (to reduce allocation overhead). Each variable is prefixed by the method in which is used:
     //
     vec<char>           analyze_seen;
+    vec<int64>          lbd_stamp;        // 'lbd_stamp[level]' is the last 'lbd_stamp_cur' seen at 'level' by 'computeLBD()'.
+    int64               lbd_stamp_cur;
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
-    Clause*             propagate_tmpbin;
-    Clause*             analyze_tmpbin;
     vec<Lit>            addUnit_tmp;
     vec<Lit>            addBinary_tmp;
     vec<Lit>            addTernary_tmp;
+    vec<Lit>            importShared_tmp;
 
     // Main internal methods:
     //
@@ -91,14 +126,23 @@ protected:
     void        cancelUntil      (int level);
     void        record           (const vec<Lit>& clause);
 
-    void        analyze          (Clause* confl, vec<Lit>& out_learnt, int& out_btlevel); // (bt = backtrack)
+    void        analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_lbd); // (bt = backtrack)
     bool        analyze_removable(Lit p, uint min_level);                                 // (helper method for 'analyze()')
-    void        analyzeFinal     (Clause* confl, bool skip_first = false);
-    bool        enqueue          (Lit fact, Clause* from = NULL);
-    Clause*     propagate        ();
+    void        analyzeFinal     (CRef confl, bool skip_first = false);
+    bool        enqueue          (Lit fact, CRef from = CRef_Undef);
+    Clause&     reasonClause     (Var x);                                                 // 'reason[x]' with the literal of 'x' moved to position 0.
+    void        proofUnit        (const Clause& c);                                       // Log the unit 'c[0]' derived at top-level.
+    CRef        propagate        ();
     void        reduceDB         ();
+    void        checkGarbage     ();                                                      // Compact 'ca' if enough of it is wasted.
+    void        garbageCollect   ();
+    template<class C>
+    int         computeLBD       (const C& c);                                            // Number of distinct decision levels in 'c'.
+    bool        glucoseRestart   (int lbd, const SearchParams& params);                   // Record 'lbd', TRUE if a glucose restart is due.
     Lit         pickBranchLit    (const SearchParams& params);
     lbool       search           (int nof_conflicts, int nof_learnts, const SearchParams& params);
+    bool        withinBudget     () const;
+    void        importShared     ();                                                      // Add the clauses learnt by the rest of the portfolio.
     double      progressEstimate ();
 
     // Activity:
@@ -115,10 +159,12 @@ protected:
     // Operations on clauses:
     //
     void     newClause(const vec<Lit>& ps, bool learnt = false, ClauseId id = ClauseId_NULL, bool A = true);
-    void     claBumpActivity (Clause* c) { if ( (c->activity() += cla_inc) > 1e20 ) claRescaleActivity(); }
-    void     remove          (Clause* c, bool just_dealloc = false);
-    bool     locked          (const Clause* c) const { return reason[var((*c)[0])] == c; }
-    bool     simplify        (Clause* c) const;
+    void     claBumpActivity (Clause& c) { if ( (c.activity() += cla_inc) > 1e20 ) claRescaleActivity(); }
+    void     remove          (CRef cr);
+    bool     locked          (CRef cr) const {
+        const Clause& c = ca[cr];
+        return reason[var(c[0])] == cr || (c.size() == 2 && reason[var(c[1])] == cr); }
+    bool     simplify        (CRef cr) const;
 
     int      decisionLevel() const { return trail_lim.size(); }
 
@@ -128,31 +174,37 @@ public:
              , cla_decay        (1)
              , var_inc          (1)
              , var_decay        (1)
+             , var_decay_cur    (-1)
              , order            (assigns, activity)
              , qhead            (0)
              , simpDB_assigns   (0)
              , simpDB_props     (0)
-             , default_params   (SearchParams(0.95, 0.999, 0.02))
+             , lbd_queue_head   (0)
+             , lbd_queue_sum    (0)
+             , lbd_sum          (0)
+             , learnts_core     (0)
+             , lbd_stamp_cur    (0)
+             , default_params   (SearchParams(0.95, 0.999, 0.02, restart_Luby, 100, 2, true))
              , expensive_ccmin  (2)
+             , core_lbd         (2)
+             , tier2_lbd        (6)
+             , garbage_frac     (0.20)
              , proof            (NULL)
+             , portfolio        (NULL)
+             , portfolio_id     (0)
              , verbosity        (0)
+             , conflict_budget  (-1)
+             , propagation_budget(-1)
              , progress_estimate(0)
              , conflict_id      (ClauseId_NULL)
              {
-                vec<Lit> dummy(2,lit_Undef);
-                propagate_tmpbin = Clause_new(false, dummy);
-                analyze_tmpbin   = Clause_new(false, dummy);
+                default_params.var_decay_start = 0.8;
                 addUnit_tmp   .growTo(1);
                 addBinary_tmp .growTo(2);
                 addTernary_tmp.growTo(3);
              }
 
-   ~Solver() {
-       for (int i = 0; i < learnts.size(); i++) remove(learnts[i], true);
-       for (int i = 0; i < clauses.size(); i++) if (clauses[i] != NULL) remove(clauses[i], true);
-       remove(propagate_tmpbin, true);
-       remove(analyze_tmpbin, true);
-    }
+   ~Solver() { }   // (the clauses go with 'ca')
 
     // Helpers: (semi-internal)
     //
@@ -173,13 +225,21 @@ public:
     //
     SearchParams    default_params;     // Restart frequency etc.
     int             expensive_ccmin;    // Controls conflict clause minimization. TRUE by default.
+    int             core_lbd;           // Learnt clauses with LBD <= this are never removed by 'reduceDB()'.
+    int             tier2_lbd;          // Learnt clauses with LBD <= this are kept as long as they are used between two 'reduceDB()'.
+    double          garbage_frac;       // Compact the clause arena when this fraction of it is wasted.
     Proof*          proof;              // Set this directly after constructing 'Solver' to enable proof logging. Initialized to NULL.
+    Portfolio*      portfolio;          // Set this (and 'portfolio_id') directly when the solver is one of a portfolio: short learnt clauses are
+    int             portfolio_id;       // exchanged with the others, and 'solveLimited()' gives up once another one has finished.
     int             verbosity;          // Verbosity level. 0=silent, 1=some progress report, 2=everything
+    void            setRandomSeed(double seed) { order.setSeed(seed); }
 
     // Problem specification:
     //
     Var     newVar    ();
     int     nVars     ()                    { return assigns.size(); }
+    template<class S>
+    void    copyProblem(S& dst) const;        // Copy the variables, top-level units and problem clauses into the empty solver 'dst'.
     void    addUnit   (Lit p)               { addUnit_tmp   [0] = p; addClause(addUnit_tmp); }
     void    addBinary (Lit p, Lit q)        { addBinary_tmp [0] = p; addBinary_tmp [1] = q; addClause(addBinary_tmp); }
     void    addTernary(Lit p, Lit q, Lit r) { addTernary_tmp[0] = p; addTernary_tmp[1] = q; addTernary_tmp[2] = r; addClause(addTernary_tmp); }
@@ -192,6 +252,15 @@ public:
     void    simplifyDB();
     bool    solve(const vec<Lit>& assumps);
     bool    solve() { vec<Lit> tmp; return solve(tmp); }
+    lbool   solveLimited(const vec<Lit>& assumps);  // Like 'solve()' but returns 'l_Undef' if the budget below runs out.
+
+    // Resource constraints: (negative value means no limit)
+    //
+    int64   conflict_budget;    // Stop 'solveLimited()' after this many conflicts in total ('stats.conflicts').
+    int64   propagation_budget; // Stop 'solveLimited()' after this many propagations in total ('stats.propagations').
+    void    setConfBudget(int64 x) { conflict_budget    = stats.conflicts    + x; }
+    void    setPropBudget(int64 x) { propagation_budget = stats.propagations + x; }
+    void    budgetOff    ()        { conflict_budget = propagation_budget = -1; }
 
     double      progress_estimate;  // Set by 'search()'.
     vec<lbool>  model;              // If problem is satisfiable, this vector contains the model (if any).
@@ -201,9 +270,40 @@ public:
     // Printing:
     //
     void printStats();
+    void toDimacs(FILE* out, const vec<Lit>& assumps);  // Problem clauses, top-level assignments and 'assumps' in DIMACS CNF.
 };
 
 
+// Give the empty solver 'dst' (a 'Solver', or anything with 'newVar()', 'nVars()' and 'addClause()',
+// e.g. a 'Simplifier') the same problem: the variables, the top-level assignments (as units) and
+// the problem clauses. Learnt clauses are left out. Must be called at decision level 0 (i.e.
+// outside of 'solve()').
+//
+template<class S>
+void Solver::copyProblem(S& dst) const
+{
+    assert(decisionLevel() == 0 && dst.nVars() == 0);
+    while (dst.nVars() < assigns.size())
+        dst.newVar();
+
+    vec<Lit>    lits;
+    if (!ok){
+        dst.addClause(lits);    // (the empty clause)
+        return; }
+    for (int i = 0; i < trail.size(); i++){
+        lits.clear();
+        lits.push(trail[i]);
+        dst.addClause(lits); }
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        lits.clear();
+        for (int j = 0; j < c.size(); j++)
+            lits.push(c[j]);
+        dst.addClause(lits);
+    }
+}
+
+
 //=================================================================================================
 // Debug:
 
@@ -82,35 +82,106 @@ const   int ClauseId_NULL = INT_MIN;
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 class Clause {
-    uint    size_learnt;
+    uint    header;     // (size << 3) | (reloced << 2) | (has_id << 1) | learnt
     Lit     data[1];
 public:
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
     Clause(bool learnt, const vec<Lit>& ps, ClauseId id_ = ClauseId_NULL) {
-        size_learnt = (ps.size() << 1) | (int)learnt;
+        header = (ps.size() << 3) | ((int)(id_ != ClauseId_NULL) << 1) | (int)learnt;
         for (int i = 0; i < ps.size(); i++) data[i] = ps[i];
-        if (learnt) activity() = 0;
+        if (learnt) activity() = 0, lbd_used() = 0;
         if (id_ != ClauseId_NULL) id() = id_; }
 
-    // -- use this function instead:
-    friend Clause* Clause_new(bool, const vec<Lit>&, ClauseId);
+    // -- use 'ClauseAllocator::alloc()' instead:
+    friend class ClauseAllocator;
 
-    int       size        ()      const { return size_learnt >> 1; }
-    bool      learnt      ()      const { return size_learnt & 1; }
+    int       size        ()      const { return header >> 3; }
+    bool      learnt      ()      const { return header & 1; }
     Lit       operator [] (int i) const { return data[i]; }
     Lit&      operator [] (int i)       { return data[i]; }
     float&    activity    ()      const {
         void *p = const_cast<Lit*>(&data[size()]); return *((float *)p);
     } //              return *((float*)&data[size()]); }
-    ClauseId& id          ()      const { return *((ClauseId*)&data[size() + (int)learnt()]); }
+    ClauseId& id          ()      const { return *((ClauseId*)&data[size() + 2*(int)learnt()]); }
+
+    // Learnt clauses only: literal block distance, and whether the clause took part in a conflict
+    // analysis since the last 'reduceDB()'. Both are packed in the word after 'activity()'.
+    uint      lbd         ()      const { return lbd_used() & 0x7fffffff; }
+    void      setLbd      (uint l)      { lbd_used() = (lbd_used() & 0x80000000) | l; }
+    bool      used        ()      const { return lbd_used() >> 31; }
+    void      setUsed     (bool u)      { lbd_used() = (lbd_used() & 0x7fffffff) | ((uint)u << 31); }
+private:
+    uint&     lbd_used    ()      const {
+        void *p = const_cast<Lit*>(&data[size() + 1]); return *((uint *)p); }
+
+    // Size in 32-bit words, including the header.
+    int       words       ()      const { return 1 + size() + 2*(int)learnt() + (int)((header >> 1) & 1); }
+    // After the clause is moved by garbage collection, 'data[0]' holds its new reference.
+    bool      reloced     ()      const { return header & 4; }
+    uint&     relocation  ()      const {
+        void *p = const_cast<Lit*>(&data[0]); return *((uint *)p); }
+    void      relocate    (uint to)     { header |= 4; relocation() = to; }
 };
 
-inline Clause* Clause_new(bool learnt, const vec<Lit>& ps, ClauseId id = ClauseId_NULL) {
-    assert(sizeof(Lit)      == sizeof(uint));
-    assert(sizeof(float)    == sizeof(uint));
-    assert(sizeof(ClauseId) == sizeof(uint));
-    void*   mem = xmalloc<char>(sizeof(Clause) + sizeof(uint)*(ps.size() + (int)learnt + (int)(id != ClauseId_NULL)));
-    return new (mem) Clause(learnt, ps, id); }
+
+//=================================================================================================
+// ClauseAllocator -- all clauses live in one growable arena and are referred to by 32-bit offsets:
+
+
+typedef uint CRef;
+const   CRef CRef_Undef = UINT_MAX;
+
+class ClauseAllocator {
+    uint*   mem;
+    uint    sz;
+    uint    cap;
+    uint    wasted_;    // Words of freed clauses, reclaimed by 'reloc()' into a new allocator.
+
+    void    capacity(uint min_cap) {
+        if (cap >= min_cap) return;
+        while (cap < min_cap) cap += (cap >> 1) + 8;    // (grow by ~1.5)
+        mem = xrealloc(mem, cap); }
+
+public:
+    ClauseAllocator(uint start_cap = 64*1024) : mem(NULL), sz(0), cap(0), wasted_(0) { capacity(start_cap); }
+   ~ClauseAllocator() { xfree(mem); }
+
+    // NOTE! May move the arena: references ('Clause&') obtained before are invalidated, 'CRef's are not.
+    CRef    alloc(bool learnt, const vec<Lit>& ps, ClauseId id = ClauseId_NULL) {
+        assert(sizeof(Lit)      == sizeof(uint));
+        assert(sizeof(float)    == sizeof(uint));
+        assert(sizeof(ClauseId) == sizeof(uint));
+        uint    words = 1 + ps.size() + 2*(int)learnt + (int)(id != ClauseId_NULL);
+        capacity(sz + words);
+        CRef    cr = sz;
+        sz += words;
+        new (&mem[cr]) Clause(learnt, ps, id);
+        return cr; }
+    void    free(CRef cr) { wasted_ += (*this)[cr].words(); }
+
+    Clause&       operator [] (CRef cr)       { return *((Clause*)&mem[cr]); }
+    const Clause& operator [] (CRef cr) const { return *((const Clause*)&mem[cr]); }
+
+    uint    size  () const { return sz; }
+    uint    wasted() const { return wasted_; }
+
+    // Copy the clause 'cr' into 'to' (once) and update 'cr' to refer to the copy.
+    void    reloc(CRef& cr, ClauseAllocator& to) {
+        Clause& c = (*this)[cr];
+        if (c.reloced()){ cr = c.relocation(); return; }
+        uint    words = c.words();
+        to.capacity(to.sz + words);
+        CRef    ncr = to.sz;
+        to.sz += words;
+        memcpy(&to.mem[ncr], &mem[cr], words * sizeof(uint));
+        c.relocate(ncr);
+        cr = ncr; }
+
+    void    moveTo(ClauseAllocator& to) {
+        xfree(to.mem);
+        to.mem = mem; to.sz = sz; to.cap = cap; to.wasted_ = wasted_;
+        mem = NULL; sz = cap = wasted_ = 0; }
+};
 
 
 //=================================================================================================
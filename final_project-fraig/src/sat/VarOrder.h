@@ -45,6 +45,7 @@ public:
         assigns(ass), heap(VarOrder_lt(act)), random_seed(91648253)
         { }
 
+    void        setSeed(double seed) { assert(seed > 0); random_seed = seed; }    // (must never be 0)
     inline void newVar(void);
     inline void update(Var x);                  // Called when variable increased in activity.
     inline void undo(Var x);                    // Called when variable is unassigned and may be selected again.
@@ -11,16 +11,42 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
 #include "Solver.h"
+#include "Simplifier.h"
+#include "myStats.h"
 
 using namespace std;
 
+/********** SatStats **********/
+// Snapshot of the solver statistics, accumulated over all the solve calls
+struct SatStats
+{
+   SatStats(): solves(0), sats(0), unsats(0), undefs(0), decisions(0), propagations(0),
+               conflicts(0), learntLits(0), time(0) { }
+   SatStats& operator += (const SatStats& s) {
+      solves += s.solves; sats += s.sats; unsats += s.unsats; undefs += s.undefs;
+      decisions += s.decisions; propagations += s.propagations;
+      conflicts += s.conflicts; learntLits += s.learntLits; time += s.time;
+      return *this;
+   }
+
+   int64    solves, sats, unsats, undefs;   // number of solve calls by result
+   int64    decisions, propagations, conflicts;
+   int64    learntLits;                     // literals in all the learnt clauses
+   double   time;                           // seconds spent in the solve calls
+};
+
 /********** MiniSAT_Solver **********/
 class SatSolver
 {
    public : 
-      SatSolver():_solver(0) { }
-      ~SatSolver() { if (_solver) delete _solver; }
+      SatSolver():_solver(0), _portfolio(0), _result(0), _preprocess(false) { }
+      ~SatSolver() { setPortfolio(1); if (_solver) delete _solver; }
 
       // Solver initialization and reset
       void initialize() {
@@ -28,14 +54,19 @@ class SatSolver
          if (_curVar == 0) { _solver->newVar(); ++_curVar; }
       }
       void reset() {
+         setPortfolio(1);
          if (_solver) delete _solver;
-         _solver = new Solver();
-         _assump.clear(); _curVar = 0;
+         _solver = new Solver(); _result = _solver;
+         _assump.clear(); _frozen.clear(); _curVar = 0; _stats = SatStats();
       }
 
       // Constructing proof model
       // Return the Var ID of the new Var
-      inline Var newVar() { _solver->newVar(); return _curVar++; }
+      inline Var newVar() {
+         _solver->newVar();
+         for (size_t i = 0; i < _others.size(); ++i) _others[i]->newVar();
+         return _curVar++;
+      }
       // fa/fb = true if it is inverted
       void addAigCNF(Var vf, Var va, bool fa, Var vb, bool fb) {
          vec<Lit> lits;
@@ -43,11 +74,11 @@ class SatSolver
          Lit la = fa? ~Lit(va): Lit(va);
          Lit lb = fb? ~Lit(vb): Lit(vb);
          lits.push(la); lits.push(~lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
          lits.push(lb); lits.push(~lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
          lits.push(~la); lits.push(~lb); lits.push(lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
       }
       // fa/fb = true if it is inverted
       void addXorCNF(Var vf, Var va, bool fa, Var vb, bool fb) {
@@ -56,39 +87,222 @@ class SatSolver
          Lit la = fa? ~Lit(va): Lit(va);
          Lit lb = fb? ~Lit(vb): Lit(vb);
          lits.push(~la); lits.push( lb); lits.push( lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
          lits.push( la); lits.push(~lb); lits.push( lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
          lits.push( la); lits.push( lb); lits.push(~lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
          lits.push(~la); lits.push(~lb); lits.push(~lf);
-         _solver->addClause(lits); lits.clear();
+         addClause(lits); lits.clear();
       }
 
+      // Clause groups, for constraints which are only needed by a few solves:
+      // the clauses of group "g" hold only while "enableGroup(g)" is in the
+      // assumptions; "releaseGroup(g)" disables them for good, and they are
+      // removed from the database by the next "simplifyDB()"
+      inline Var newGroup() { return newVar(); }
+      void addGroupClause(Var g, vec<Lit>& lits) {
+         lits.push(~Lit(g));
+         addClause(lits);
+      }
+      // (va ^ fa) != (vb ^ fb) while "g" is enabled; fa/fb = true if it is inverted
+      void addGroupXorCNF(Var g, Var va, bool fa, Var vb, bool fb) {
+         vec<Lit> lits;
+         Lit la = fa? ~Lit(va): Lit(va);
+         Lit lb = fb? ~Lit(vb): Lit(vb);
+         lits.push( la); lits.push( lb);
+         addGroupClause(g, lits); lits.clear();
+         lits.push(~la); lits.push(~lb);
+         addGroupClause(g, lits);
+      }
+      void enableGroup(Var g) { _assump.push(Lit(g)); }
+      void releaseGroup(Var g) { addUnit(~Lit(g)); }
+
       // For incremental proof, use "assumeSolve()"
       void assumeRelease() { _assump.clear(); }
       void assumeProperty(Var prop, bool val) {
          _assump.push(val? Lit(prop): ~Lit(prop));
       }
-      bool assumpSolve() { return _solver->solve(_assump); }
+      bool assumpSolve() { return assumpSolveLimited(-1) == l_True; }
+      // Budgeted version of "assumpSolve()"; negative budget means no limit
+      // Return l_True/l_False, or l_Undef if the budget runs out first
+      // (with a portfolio, every solver has the budget; see "setPortfolio()")
+      lbool assumpSolveLimited(int64 confBudget, int64 propBudget = -1) {
+         Clock::time_point start = Clock::now();
+         lbool ret = _others.empty()?
+            solveLimited(_solver, confBudget, propBudget):
+            portfolioSolve(confBudget, propBudget);
+         record(ret, start);
+         return ret;
+      }
+
+      // Solve the assumptions with "n" diversified solvers (seed, restart and
+      // phase policies) in parallel threads, n <= 1 means a single solver. The
+      // first one to finish answers; learnt clauses of at most
+      // Portfolio::max_size literals are shared. The other solvers start from a
+      // copy of the current problem, so it can be set between any two solves.
+      void setPortfolio(int n) {
+         for (size_t i = 0; i < _others.size(); ++i) delete _others[i];
+         _others.clear();
+         if (_portfolio) { delete _portfolio; _portfolio = 0; }
+         if (!_solver) return;
+         _solver->portfolio = 0; _result = _solver;
+         if (n <= 1) return;
+         _portfolio = new Portfolio(n);
+         _solver->portfolio = _portfolio; _solver->portfolio_id = 0;
+         for (int i = 1; i < n; ++i) {
+            Solver* s = new Solver();
+            _solver->copyProblem(*s);
+            diversify(*s, i);
+            s->portfolio = _portfolio; s->portfolio_id = i;
+            _others.push_back(s);
+         }
+      }
 
       // For one time proof, use "solve"
       void assertProperty(Var prop, bool val) {
-         _solver->addUnit(val? Lit(prop): ~Lit(prop));
+         addUnit(val? Lit(prop): ~Lit(prop));
+      }
+      // Return true if it is satisfiable
+      bool solve() {
+         Clock::time_point start = Clock::now();
+         _result = _solver;
+         bool ret = _preprocess? preprocessSolve(): _solver->solve();
+         record(ret? l_True: l_False, start);
+         return ret;
       }
-      bool solve() { _solver->solve(); return _solver->okay(); }
+      // Simplify the problem (see "Simplifier") before searching in "solve()";
+      // the frozen variables are kept as they are, but the model is complete
+      // either way. The incremental solves are not affected.
+      void setPreprocess(bool on) { _preprocess = on; }
+      void freeze(Var v) { _frozen.push_back(v); }
 
       // Functions about Reporting
       // Return 1/0/-1; -1 means unknown value
       int getValue(Var v) const {
-         return (_solver->modelValue(v)==l_True?1:
-                (_solver->modelValue(v)==l_False?0:-1)); }
+         return (_result->modelValue(v)==l_True?1:
+                (_result->modelValue(v)==l_False?0:-1)); }
+      // Model of the last satisfiable solve; l_Undef if unknown
+      lbool getModelValue(Var v) const {
+         return v < _result->model.size()? _result->modelValue(v): l_Undef; }
+      // The assumptions (as given to "assumeProperty()") which make the last
+      // assumption solve unsatisfiable; empty if it is unsatisfiable by itself
+      void getConflict(vector<pair<Var, bool> >& core) const {
+         core.clear();
+         for (int i = 0; i < _result->conflict.size(); ++i) {
+            Lit p = _result->conflict[i];   // (negation of an assumption)
+            core.push_back(make_pair(var(p), sign(p)));
+         }
+      }
+      // (with a portfolio, the search statistics are summed over its solvers)
+      SatStats getStats() const {
+         SatStats s = _stats;
+         for (size_t i = 0; i <= _others.size(); ++i) {
+            const Solver* solver = i? _others[i-1]: _solver;
+            s.decisions += solver->stats.decisions;
+            s.propagations += solver->stats.propagations;
+            s.conflicts += solver->stats.conflicts;
+            s.learntLits += solver->stats.tot_literals;
+         }
+         return s;
+      }
       void printStats() const { const_cast<Solver*>(_solver)->printStats(); }
+      // Dump the CNF with the current assumptions as unit clauses (see "Solver::toDimacs()")
+      bool writeDimacs(const string& fileName) const {
+         FILE* out = fopen(fileName.c_str(), "w");
+         if (!out) return false;
+         _solver->toDimacs(out, _assump);
+         fclose(out);
+         return true;
+      }
 
    private : 
+      typedef chrono::steady_clock Clock;
+
+      void addClause(const vec<Lit>& lits) {
+         _solver->addClause(lits);
+         for (size_t i = 0; i < _others.size(); ++i) _others[i]->addClause(lits);
+      }
+      void addUnit(Lit p) { vec<Lit> lits; lits.push(p); addClause(lits); }
+
+      lbool solveLimited(Solver* s, int64 confBudget, int64 propBudget) const {
+         s->budgetOff();
+         if (confBudget >= 0) s->setConfBudget(confBudget);
+         if (propBudget >= 0) s->setPropBudget(propBudget);
+         lbool ret = s->solveLimited(_assump);
+         s->budgetOff();
+         return ret;
+      }
+      // The i-th (i >= 1) solver of a portfolio; the first one keeps the defaults
+      static void diversify(Solver& s, int i) {
+         SearchParams& p = s.default_params;
+         switch (i % 3) {
+            case 1: p.restart = restart_Glucose; break;
+            case 2: p.restart = restart_Geometric; p.restart_inc = 1.5; break;
+            default: p.restart_first = 100 * (1 + i / 3); break;  // (Luby, another unit)
+         }
+         p.phase_saving = (i % 2 == 0);
+         p.random_var_freq = 0.02 * (1 + i % 4);
+         s.setRandomSeed(91648253 + 7919.0 * i);
+      }
+      // The first solver to finish stops the others
+      lbool portfolioSolve(int64 confBudget, int64 propBudget) {
+         int n = _others.size() + 1;
+         vector<lbool> results(n, l_Undef);
+         atomic<int> winner(-1);
+         _portfolio->restart();
+         auto run = [&](int i) {
+            results[i] = solveLimited(i? _others[i-1]: _solver, confBudget, propBudget);
+            int none = -1;
+            if (results[i] != l_Undef && winner.compare_exchange_strong(none, i))
+               _portfolio->stop();
+         };
+         vector<thread> threads;
+         for (int i = 1; i < n; ++i) threads.push_back(thread(run, i));
+         run(0);
+         for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+         _result = winner > 0? _others[winner-1]: _solver;
+         return winner < 0? l_Undef: results[winner];
+      }
+
+      // Solve a simplified copy of the problem; its model is extended back
+      // into "_solver" (so the problem in "_solver" stays as it was)
+      bool preprocessSolve() {
+         Simplifier simp;
+         _solver->copyProblem(simp);
+         for (size_t i = 0; i < _frozen.size(); ++i) simp.freeze(_frozen[i]);
+         _solver->model.clear();
+         if (!simp.simplify()) return false;
+         Solver s;
+         simp.copyTo(s);
+         bool ret = s.solve();
+         _stats.decisions += s.stats.decisions;
+         _stats.propagations += s.stats.propagations;
+         _stats.conflicts += s.stats.conflicts;
+         _stats.learntLits += s.stats.tot_literals;
+         if (!ret) return false;
+         s.model.copyTo(_solver->model);
+         simp.extendModel(_solver->model);
+         return true;
+      }
+
+      void record(lbool ret, Clock::time_point start) {
+         ++_stats.solves;
+         if (ret == l_True) { ++_stats.sats; STAT_ADD(STAT_SAT_SAT, 1); }
+         else if (ret == l_False) { ++_stats.unsats; STAT_ADD(STAT_SAT_UNSAT, 1); }
+         else { ++_stats.undefs; STAT_ADD(STAT_SAT_UNDEF, 1); }
+         _stats.time += chrono::duration<double>(Clock::now() - start).count();
+      }
+
       Solver           *_solver;    // Pointer to a Minisat solver
+      vector<Solver*>   _others;    // The rest of the portfolio (empty: no portfolio)
+      Portfolio        *_portfolio; // Shared by "_solver" and "_others"
+      Solver           *_result;    // The solver which answered the last solve
       Var               _curVar;    // Variable currently
       vec<Lit>          _assump;    // Assumption List for assumption solve
+      SatStats          _stats;     // Solve calls and time, the search of the preprocessed solves; the rest is read from _solver
+      bool              _preprocess;// Simplify in "solve()"
+      vector<Var>       _frozen;    // Variables kept by the preprocessing
 };
 
 #endif  // SAT_H
@@ -0,0 +1 @@
+../Dimacs.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Portfolio.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Simplifier.cpp
\ No newline at end of file
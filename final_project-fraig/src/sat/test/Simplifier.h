@@ -0,0 +1 @@
+../Simplifier.h
\ No newline at end of file
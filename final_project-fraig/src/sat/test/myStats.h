@@ -0,0 +1 @@
+../../util/myStats.h
\ No newline at end of file
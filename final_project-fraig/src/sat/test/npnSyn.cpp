@@ -0,0 +1,476 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <chrono>
+#include <cstdlib>
+#include "Solver.h"
+
+using namespace std;
+
+// Exact synthesis of the 4-input NPN classes: for the representative (the smallest truth table)
+// of each of the 222 classes, find an AIG with the fewest AND gates. An enumeration of the sets
+// of functions that k gates can compute gives the lower bound, a Shannon expansion the upper
+// bound, then the Solver is asked for r gates from the lower bound up. Fanins may be inverted
+// and so may the output, which makes a gate a 2-input function with exactly one true minterm.
+// The output is the table of "cirRewrite.cpp":
+//    { truth, gate number, output literal, { fanin literals of the gates } }
+// where literal 2 * v + inverted: v = 0 is CONST 0, v = 1..4 the inputs, v = 5.. the gates.
+static const int INPUT_NUM = 4;
+static const int ROW_NUM = 1 << INPUT_NUM;
+static const unsigned VAR_TRUTH[INPUT_NUM] = { 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+
+// g(x) = neg_out ^ f(y) with y[i] = x[perm[i]] ^ bit i of neg_in
+static unsigned
+npnTransform(unsigned f, const int* perm, unsigned negIn, bool negOut)
+{
+   unsigned g = 0;
+   for (int row = 0; row < ROW_NUM; ++row) {
+      int from = 0;
+      for (int i = 0; i < INPUT_NUM; ++i)
+         if (((row >> perm[i]) & 1) ^ ((negIn >> i) & 1)) from |= 1 << i;
+      if (((f >> from) & 1) ^ negOut) g |= 1 << row;
+   }
+   return g;
+}
+
+static void
+npnClasses(vector<unsigned>& reps)
+{
+   vector<bool> done(1 << ROW_NUM, false);
+   for (unsigned f = 0; f < done.size(); ++f) {
+      if (done[f]) continue;
+      reps.push_back(f);
+      int perm[INPUT_NUM] = { 0, 1, 2, 3 };
+      do {
+         for (unsigned negIn = 0; negIn < ROW_NUM; ++negIn)
+            for (int negOut = 0; negOut < 2; ++negOut)
+               done[npnTransform(f, perm, negIn, negOut)] = true;
+      } while (next_permutation(perm, perm + INPUT_NUM));
+   }
+}
+
+// Lower bounds by enumeration. The gates of an AIG in topological order compute a set of
+// functions, and a set of k + 1 gates is one of k gates plus an AND of two of its nodes (or the
+// inputs), inverted or not. The sets are kept up to the NPN transformations of the inputs, with
+// every function complemented to be 0 on row 0, so a level is sorted and made unique. The first
+// level with a function in a set is its cost; beyond the last level (SET_GATE_NUM gates) a gate
+// is added to every set, then another one, which must use the first, for the classes not found
+// yet. A class not found in them needs more than SET_GATE_NUM + 2 gates.
+class SetEnumeration
+{
+public:
+   static const int SET_GATE_NUM = 8;   // 93M sets of 8 gates, 1.5 GB
+   static const int TRANS_NUM = 24 * ROW_NUM;   // permutations x input negations
+   static const int FUNC_NUM = 1 << ROW_NUM;
+   typedef unsigned short Func;
+   typedef vector<Func> Sets;   // k functions per set, sorted
+
+   SetEnumeration(): _trans(TRANS_NUM * FUNC_NUM), _classMin(FUNC_NUM), _toMin(FUNC_NUM),
+                     _cost(FUNC_NUM, -1) {
+      int perm[INPUT_NUM] = { 0, 1, 2, 3 };
+      for (int t = 0; t < TRANS_NUM; t += ROW_NUM, next_permutation(perm, perm + INPUT_NUM))
+         for (unsigned negIn = 0; negIn < ROW_NUM; ++negIn)
+            for (unsigned f = 0; f < FUNC_NUM; ++f)
+               _trans[(t + negIn) * FUNC_NUM + f] = npnTransform(f, perm, negIn, false);
+      for (unsigned f = 0; f < FUNC_NUM; ++f) {
+         _classMin[f] = FUNC_NUM - 1;
+         for (int t = 0; t < TRANS_NUM; ++t) _classMin[f] = std::min(_classMin[f], norm(trans(t, f)));
+         for (int t = 0; t < TRANS_NUM; ++t)
+            if (norm(trans(t, f)) == _classMin[f]) _toMin[f].push_back(t);
+      }
+   }
+   // the number of gates of every class, or SET_GATE_NUM + 3 as a lower bound
+   void costs(const vector<unsigned>& reps, vector<int>& cost) {
+      setCost(0, 0);
+      for (int i = 0; i < INPUT_NUM; ++i) setCost(VAR_TRUTH[i], 0);
+      Sets level(1), next;   // (one empty set)
+      for (int k = 0; k < SET_GATE_NUM; ++k) {
+         expand(level, k, next);
+         level.swap(next);
+         for (auto f : level) setCost(f, k + 1);
+         cerr << "sets of " << k + 1 << " gates: " << level.size() / (k + 1) << endl;
+      }
+      const int k = SET_GATE_NUM, n = INPUT_NUM + k;
+      Func nodes[INPUT_NUM + SET_GATE_NUM + 1];
+      copy(VAR_TRUTH, VAR_TRUTH + INPUT_NUM, nodes);
+      for (size_t s = 0; s < level.size(); s += k) {
+         copy(&level[s], &level[s] + k, nodes + INPUT_NUM);
+         for (int a = 0; a < n; ++a)
+            for (int b = a + 1; b < n; ++b)
+               for (int pq = 0; pq < 4; ++pq) setCost(gate(nodes[a], nodes[b], pq), k + 1);
+      }
+      vector<char> target(FUNC_NUM, 0);
+      bool any = false;
+      for (auto f : reps)
+         if (_cost[f] < 0) {
+            for (int t = 0; t < TRANS_NUM; ++t) target[trans(t, f)] = target[trans(t, f) ^ 0xFFFF] = 1;
+            any = true;
+         }
+      for (size_t s = 0; any && s < level.size(); s += k) {
+         copy(&level[s], &level[s] + k, nodes + INPUT_NUM);
+         for (int a = 0; a < n; ++a)
+            for (int b = a + 1; b < n; ++b)
+               for (int pq = 0; pq < 4; ++pq) {
+                  Func g = gate(nodes[a], nodes[b], pq);
+                  for (int c = 0; c < n; ++c)
+                     for (int inv = 0; inv < 4; ++inv) {
+                        Func f = gate(g, nodes[c], inv);
+                        if (target[f]) setCost(f, k + 2);
+                     }
+               }
+      }
+      cost.clear();
+      for (auto f : reps) cost.push_back(_cost[f] < 0 ? k + 3 : _cost[f]);
+   }
+
+private:
+   vector<Func> _trans;               // _trans[t * FUNC_NUM + f]: f under transformation t
+   vector<Func> _classMin;            // the smallest normalized function of the class
+   vector<vector<short> > _toMin;     // the transformations giving it
+   vector<int> _cost;
+
+   Func trans(int t, Func f) const { return _trans[t * FUNC_NUM + f]; }
+   static Func norm(Func f) { return (f & 1) ? f ^ 0xFFFF : f; }
+   // a AND b with a inverted if bit 0 of "inv", b if bit 1
+   static Func gate(Func a, Func b, int inv) {
+      return ((inv & 1) ? a ^ 0xFFFF : a) & ((inv & 2) ? b ^ 0xFFFF : b);
+   }
+   // the class of "f" costs at most "k"
+   void setCost(Func f, int k) {
+      if (_cost[f] >= 0 && _cost[f] <= k) return;
+      for (int t = 0; t < TRANS_NUM; ++t) _cost[trans(t, f)] = _cost[trans(t, f) ^ 0xFFFF] = k;
+   }
+   // the smallest of the transformed sets; the first function is then the smallest _classMin
+   void canonical(const Func* set, int k, Func* result) const {
+      Func least = FUNC_NUM - 1, tmp[INPUT_NUM + SET_GATE_NUM];
+      for (int i = 0; i < k; ++i) least = std::min(least, _classMin[set[i]]);
+      bool found = false;
+      for (int i = 0; i < k; ++i) {
+         if (_classMin[set[i]] != least) continue;
+         for (auto t : _toMin[set[i]]) {
+            for (int j = 0; j < k; ++j) tmp[j] = norm(trans(t, set[j]));
+            sort(tmp, tmp + k);
+            if (!found || lexicographical_compare(tmp, tmp + k, result, result + k)) {
+               copy(tmp, tmp + k, result);
+               found = true;
+            }
+         }
+      }
+   }
+   // the sets of k + 1 gates; the new ones are sorted and merged in chunks to save memory
+   void expand(const Sets& level, int k, Sets& next) const {
+      const int n = INPUT_NUM + k, k1 = k + 1;
+      const size_t CHUNK = 8000000;   // sets
+      Sets chunk, merged;
+      next.clear();
+      auto flush = [&]() {
+         vector<unsigned> order(chunk.size() / k1);
+         for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+         auto at = [&](unsigned i) { return chunk.begin() + size_t(i) * k1; };
+         sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            return lexicographical_compare(at(a), at(a) + k1, at(b), at(b) + k1); });
+         merged.clear();
+         size_t s = 0;
+         for (size_t i = 0; i < order.size() || s < next.size(); ) {
+            if (i < order.size() && i && equal(at(order[i]), at(order[i]) + k1, at(order[i - 1]))) { ++i; continue; }
+            if (i == order.size() || (s < next.size() &&
+                lexicographical_compare(next.begin() + s, next.begin() + s + k1, at(order[i]), at(order[i]) + k1))) {
+               merged.insert(merged.end(), next.begin() + s, next.begin() + s + k1);
+               s += k1;
+               continue;
+            }
+            if (s < next.size() && equal(next.begin() + s, next.begin() + s + k1, at(order[i]))) s += k1;
+            merged.insert(merged.end(), at(order[i]), at(order[i]) + k1);
+            ++i;
+         }
+         next.swap(merged);
+         chunk.clear();
+      };
+      Func nodes[INPUT_NUM + SET_GATE_NUM], set[SET_GATE_NUM], result[SET_GATE_NUM];
+      copy(VAR_TRUTH, VAR_TRUTH + INPUT_NUM, nodes);
+      for (size_t s = 0; s < level.size(); s += std::max(k, 1)) {
+         copy(level.begin() + s, level.begin() + s + k, nodes + INPUT_NUM);
+         for (int a = 0; a < n; ++a)
+            for (int b = a + 1; b < n; ++b)
+               for (int pq = 0; pq < 4; ++pq) {
+                  // a constant or a function already in the set is not in an AIG of the fewest gates
+                  Func g = norm(gate(nodes[a], nodes[b], pq));
+                  if (g == 0 || find(nodes, nodes + n, g) != nodes + n) continue;
+                  copy(nodes + INPUT_NUM, nodes + n, set);
+                  set[k] = g;
+                  canonical(set, k1, result);
+                  chunk.insert(chunk.end(), result, result + k1);
+               }
+         if (chunk.size() >= CHUNK * k1) flush();
+         if (k == 0) break;
+      }
+      flush();
+   }
+};
+
+// AIG of the Shannon expansion of "f" in the variable order "order" (a BDD with 3 gates per
+// node), sub-functions and gates are shared
+class ShannonAig
+{
+public:
+   ShannonAig(const int* order): _order(order) {
+      for (int i = 0; i <= INPUT_NUM; ++i) _value.push_back(i ? VAR_TRUTH[i - 1] : 0);
+   }
+   int build(unsigned f, int level = 0) {
+      if (f == 0 || f == 0xFFFF) return f ? 1 : 0;
+      if (_funcLit.count(f)) return _funcLit[f];
+      if (_funcLit.count(f ^ 0xFFFF)) return _funcLit[f ^ 0xFFFF] ^ 1;
+      unsigned m = VAR_TRUTH[_order[level]], shift = 1 << _order[level];
+      unsigned f1 = (f & m) | ((f & m) >> shift), f0 = (f & ~m & 0xFFFF) | ((f & ~m) << shift & 0xFFFF);
+      int lit;
+      if (f0 == f1) lit = build(f, level + 1);
+      else {
+         int x = 2 * (_order[level] + 1), lit1 = build(f1, level + 1), lit0 = build(f0, level + 1);
+         lit = aig(aig(x, lit1) ^ 1, aig(x ^ 1, lit0) ^ 1) ^ 1;
+      }
+      return _funcLit[f] = lit;
+   }
+   // the gates used by "output", renumbered
+   void get(int output, vector<int>& fanins, int& newOutput) const {
+      vector<int> newVar(_value.size(), -1);
+      for (int v = 0; v <= INPUT_NUM; ++v) newVar[v] = v;
+      vector<bool> used(_value.size(), false);
+      used[output / 2] = true;
+      for (size_t v = _value.size(); v-- > INPUT_NUM + 1; )
+         if (used[v]) used[_fanins[2 * (v - INPUT_NUM - 1)] / 2] = used[_fanins[2 * (v - INPUT_NUM - 1) + 1] / 2] = true;
+      fanins.clear();
+      for (size_t v = INPUT_NUM + 1; v < _value.size(); ++v) {
+         if (!used[v]) continue;
+         newVar[v] = INPUT_NUM + 1 + fanins.size() / 2;
+         for (int i = 0; i < 2; ++i) {
+            int lit = _fanins[2 * (v - INPUT_NUM - 1) + i];
+            fanins.push_back(2 * newVar[lit / 2] + (lit & 1));
+         }
+      }
+      newOutput = 2 * newVar[output / 2] + (output & 1);
+   }
+private:
+   const int* _order;
+   vector<unsigned> _value;   // truth table of every node
+   vector<int> _fanins;
+   map<unsigned, int> _funcLit;
+   map<pair<int, int>, int> _aigLit;
+
+   int aig(int a, int b) {
+      if (a > b) swap(a, b);
+      if (a == 0 || (a ^ b) == 1) return 0;
+      if (a == 1 || a == b) return b;
+      pair<int, int> key(a, b);
+      if (_aigLit.count(key)) return _aigLit[key];
+      unsigned va = (a & 1) ? _value[a / 2] ^ 0xFFFF : _value[a / 2];
+      unsigned vb = (b & 1) ? _value[b / 2] ^ 0xFFFF : _value[b / 2];
+      _value.push_back(va & vb);
+      _fanins.push_back(a);
+      _fanins.push_back(b);
+      return _aigLit[key] = 2 * (_value.size() - 1);
+   }
+};
+
+// the smallest Shannon expansion AIG over the 24 variable orders
+static void
+shannon(unsigned f, vector<int>& fanins, int& output)
+{
+   int order[INPUT_NUM] = { 0, 1, 2, 3 };
+   fanins.clear();
+   output = -1;
+   do {
+      ShannonAig aig(order);
+      vector<int> tryFanins;
+      int tryOutput;
+      aig.get(aig.build(f), tryFanins, tryOutput);
+      if (output < 0 || tryFanins.size() < fanins.size()) { fanins = tryFanins; output = tryOutput; }
+   } while (next_permutation(order, order + INPUT_NUM));
+}
+
+// An AIG of "r" gates computing "f" (or its complement): "fanins" gets 2 literals per gate
+static bool
+synthesize(unsigned f, int r, vector<int>& fanins, int& output)
+{
+   if (r == 0) {
+      for (int v = 0; v <= INPUT_NUM; ++v) {
+         unsigned t = 0;
+         for (int row = 0; row < ROW_NUM; ++row)
+            if (v && ((row >> (v - 1)) & 1)) t |= 1 << row;
+         if (t == f || (t ^ 0xFFFF) == f) { output = 2 * v + (t != f); return true; }
+      }
+      return false;
+   }
+
+   Solver S;
+   int nodeNum = INPUT_NUM + r;
+   // x[i][row]: value of gate i (nodes 0..3 are the inputs), m[i][pq]: minterm pq of gate i
+   vector<vector<Var> > x(nodeNum, vector<Var>(ROW_NUM, var_Undef)), m(nodeNum, vector<Var>(4, var_Undef));
+   vector<vector<pair<int, int> > > pairs(nodeNum);
+   vector<vector<Var> > sel(nodeNum);
+   for (int i = INPUT_NUM; i < nodeNum; ++i) {
+      for (int row = 0; row < ROW_NUM; ++row) x[i][row] = S.newVar();
+      for (int pq = 0; pq < 4; ++pq) m[i][pq] = S.newVar();
+      for (int k = 1; k < i; ++k)
+         for (int j = 0; j < k; ++j) { pairs[i].push_back(make_pair(j, k)); sel[i].push_back(S.newVar()); }
+   }
+   Var negOut = S.newVar();
+   vec<Lit> c;
+   // value of node j on "row" is "b": true / false as a constant for the inputs, or a literal
+   auto isnt = [&](int j, int row, int b, vec<Lit>& clause) -> bool {
+      if (j < INPUT_NUM) return ((row >> j) & 1) != b;   // (clause satisfied)
+      clause.push(Lit(x[j][row], b));
+      return false;
+   };
+   for (int i = INPUT_NUM; i < nodeNum; ++i) {
+      // exactly one true minterm
+      c.clear();
+      for (int pq = 0; pq < 4; ++pq) c.push(Lit(m[i][pq]));
+      S.addClause(c);
+      for (int a = 0; a < 4; ++a)
+         for (int b = a + 1; b < 4; ++b) S.addBinary(~Lit(m[i][a]), ~Lit(m[i][b]));
+      // at least one fanin pair
+      c.clear();
+      for (auto& s : sel[i]) c.push(Lit(s));
+      S.addClause(c);
+      for (size_t n = 0; n < pairs[i].size(); ++n) {
+         int j = pairs[i][n].first, k = pairs[i][n].second;
+         for (int row = 0; row < ROW_NUM; ++row)
+            for (int p = 0; p < 2; ++p)
+               for (int q = 0; q < 2; ++q)
+                  for (int v = 0; v < 2; ++v) {
+                     // sel & x_j == p & x_k == q & x_i == v  =>  m_pq == v
+                     c.clear();
+                     c.push(~Lit(sel[i][n]));
+                     if (isnt(j, row, p, c) || isnt(k, row, q, c)) continue;
+                     c.push(Lit(x[i][row], v));
+                     c.push(Lit(m[i][2 * p + q], !v));
+                     S.addClause(c);
+                  }
+      }
+   }
+   // symmetry breaking: every gate but the last one is used, and a gate not using the previous
+   // one comes after it in the order of the fanin pairs
+   for (int g = INPUT_NUM; g < nodeNum - 1; ++g) {
+      c.clear();
+      for (int i = g + 1; i < nodeNum; ++i)
+         for (size_t n = 0; n < pairs[i].size(); ++n)
+            if (pairs[i][n].first == g || pairs[i][n].second == g) c.push(Lit(sel[i][n]));
+      S.addClause(c);
+      for (size_t a = 0; a < pairs[g].size(); ++a)
+         for (size_t b = 0; b < pairs[g + 1].size(); ++b) {
+            pair<int, int> pa = pairs[g][a], pb = pairs[g + 1][b];
+            if (pb.second == g || pb.first == g) continue;
+            if (make_pair(pb.second, pb.first) < make_pair(pa.second, pa.first))
+               S.addBinary(~Lit(sel[g][a]), ~Lit(sel[g + 1][b]));
+         }
+   }
+   // no gate is a constant, an input or an earlier gate, or the complement of one (it would be
+   // replaced in an AIG of the fewest gates)
+   for (int i = INPUT_NUM; i < nodeNum; ++i) {
+      for (int v = 0; v < 2; ++v) {
+         c.clear();
+         for (int row = 0; row < ROW_NUM; ++row) c.push(Lit(x[i][row], v));
+         S.addClause(c);
+      }
+      for (int j = 0; j < i; ++j)
+         for (int inv = 0; inv < 2; ++inv) {
+            c.clear();
+            for (int row = 0; row < ROW_NUM; ++row) {
+               if (j < INPUT_NUM) { c.push(Lit(x[i][row], ((row >> j) & 1) ^ inv)); continue; }
+               Var d = S.newVar();   // d => x_i != x_j ^ inv on "row"
+               c.push(Lit(d));
+               S.addTernary(~Lit(d), Lit(x[i][row]), Lit(x[j][row], inv));
+               S.addTernary(~Lit(d), ~Lit(x[i][row]), Lit(x[j][row], !inv));
+            }
+            S.addClause(c);
+         }
+   }
+   // inputs a < b that "f" is symmetric in: b is not used before a
+   for (int a = 0; a < INPUT_NUM; ++a)
+      for (int b = a + 1; b < INPUT_NUM; ++b) {
+         int perm[INPUT_NUM] = { 0, 1, 2, 3 };
+         swap(perm[a], perm[b]);
+         if (npnTransform(f, perm, 0, false) != f) continue;
+         for (int i = INPUT_NUM; i < nodeNum; ++i)
+            for (size_t n = 0; n < pairs[i].size(); ++n) {
+               if (pairs[i][n].second != b || pairs[i][n].first == a) continue;
+               c.clear();
+               c.push(~Lit(sel[i][n]));
+               for (int i2 = INPUT_NUM; i2 < i; ++i2)
+                  for (size_t n2 = 0; n2 < pairs[i2].size(); ++n2)
+                     if (pairs[i2][n2].first == a || pairs[i2][n2].second == a) c.push(Lit(sel[i2][n2]));
+               S.addClause(c);
+            }
+      }
+   for (int row = 0; row < ROW_NUM; ++row) {   // x_last ^ negOut == f
+      bool v = (f >> row) & 1;
+      S.addBinary(Lit(x[nodeNum - 1][row], !v), Lit(negOut, false));
+      S.addBinary(Lit(x[nodeNum - 1][row], v), Lit(negOut, true));
+   }
+
+   if (!S.solve()) return false;
+   fanins.clear();
+   auto nodeLit = [](int j) { return 2 * (j + 1); };   // (inputs and gates are numbered in a row)
+   for (int i = INPUT_NUM; i < nodeNum; ++i) {
+      int pq = 0;
+      while (S.model[m[i][pq]] != l_True) ++pq;
+      size_t n = 0;
+      while (S.model[sel[i][n]] != l_True) ++n;
+      // minterm pq is x_j == p and x_k == q: AND of x_j (inverted if p = 0) and x_k (if q = 0)
+      fanins.push_back(nodeLit(pairs[i][n].first) + !(pq >> 1));
+      fanins.push_back(nodeLit(pairs[i][n].second) + !(pq & 1));
+   }
+   output = 2 * nodeNum + (S.model[negOut] == l_True);
+   return true;
+}
+
+// value of the synthesized AIG, to check the result
+static unsigned
+evaluate(const vector<int>& fanins, int output)
+{
+   vector<unsigned> value(INPUT_NUM + 1 + fanins.size() / 2, 0);
+   for (int i = 0; i < INPUT_NUM; ++i)
+      for (int row = 0; row < ROW_NUM; ++row)
+         if ((row >> i) & 1) value[i + 1] |= 1 << row;
+   auto litValue = [&](int lit) { return (lit & 1) ? value[lit / 2] ^ 0xFFFF : value[lit / 2]; };
+   for (size_t g = 0; g < fanins.size() / 2; ++g)
+      value[INPUT_NUM + 1 + g] = litValue(fanins[2 * g]) & litValue(fanins[2 * g + 1]);
+   return litValue(output);
+}
+
+// Every size from the lower bound to the Shannon expansion is asked until SAT, so each AIG of
+// the table is proven to have the fewest gates
+int
+main()
+{
+   typedef chrono::steady_clock Clock;
+   vector<unsigned> reps;
+   npnClasses(reps);
+   cerr << reps.size() << " NPN classes" << endl;
+   vector<int> lower;
+   SetEnumeration().costs(reps, lower);
+   for (size_t i = 0; i < reps.size(); ++i) {
+      Clock::time_point start = Clock::now();
+      unsigned f = reps[i];
+      vector<int> fanins, tryFanins;
+      int output = 0, tryOutput = 0;
+      shannon(f, fanins, output);
+      int r = lower[i], upper = fanins.size() / 2;
+      for (; r < upper; ++r)
+         if (synthesize(f, r, tryFanins, tryOutput)) {
+            fanins = tryFanins;
+            output = tryOutput;
+            break;
+         }
+      if (evaluate(fanins, output) != f) { cerr << "Error: wrong AIG for 0x" << hex << f << endl; return 1; }
+      cout << "    { 0x" << hex << setw(4) << setfill('0') << f << dec << setfill(' ')
+           << ", " << r << ", " << setw(2) << output << ", {";
+      for (size_t i = 0; i < fanins.size(); ++i) cout << (i ? ", " : " ") << fanins[i];
+      cout << (fanins.empty() ? "} }," : " } },") << endl;
+      cerr << hex << f << dec << ": " << r << " gates, "
+           << chrono::duration<double>(Clock::now() - start).count() << " s" << endl;
+   }
+   return 0;
+}
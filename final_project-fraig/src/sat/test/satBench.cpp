@@ -0,0 +1,98 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "Solver.h"
+#include "Simplifier.h"
+#include "Dimacs.h"
+
+using namespace std;
+
+// Solve a DIMACS CNF file (e.g. dumped by "CIRFraig -Dump") with the bundled
+// Solver and report the result, timing and statistics. The search options make
+// it easy to compare the solver heuristics on the same query.
+void
+usage()
+{
+   cerr << "Usage: satBench <cnf file> [-geometric | -luby | -glucose] [-nophase]\n"
+        << "                [-simp] [-conflicts (int budget)] [-verbose]" << endl;
+}
+
+int
+main(int argc, char** argv)
+{
+   if (argc < 2) { usage(); return 1; }
+
+   Solver S;
+   int64 budget = -1;
+   bool simp = false;
+   for (int i = 2; i < argc; ++i) {
+      if (strcmp(argv[i], "-geometric") == 0) {
+         S.default_params.restart = restart_Geometric;
+         S.default_params.restart_inc = 1.5;
+      }
+      else if (strcmp(argv[i], "-luby") == 0) {
+         S.default_params.restart = restart_Luby;
+         S.default_params.restart_inc = 2;
+      }
+      else if (strcmp(argv[i], "-glucose") == 0)
+         S.default_params.restart = restart_Glucose;
+      else if (strcmp(argv[i], "-nophase") == 0)
+         S.default_params.phase_saving = false;
+      else if (strcmp(argv[i], "-simp") == 0)
+         simp = true;
+      else if (strcmp(argv[i], "-conflicts") == 0 && i + 1 < argc)
+         budget = atol(argv[++i]);
+      else if (strcmp(argv[i], "-verbose") == 0)
+         S.verbosity = 1;
+      else { usage(); return 1; }
+   }
+
+   typedef chrono::steady_clock Clock;
+   Clock::time_point start = Clock::now();
+   FILE* in = fopen(argv[1], "r");
+   if (!in) { cerr << "Error: cannot open \"" << argv[1] << "\"!!" << endl; return 1; }
+   bool parsed = parseDimacs(in, S);
+   fclose(in);
+   if (!parsed) { cerr << "Error: \"" << argv[1] << "\" is not a DIMACS CNF file!!" << endl; return 1; }
+   Clock::time_point parsed_time = Clock::now();
+
+   // -simp: solve the preprocessed problem instead
+   Solver T;
+   Solver* solver = &S;
+   Simplifier pre;
+   if (simp) {
+      S.copyProblem(pre);
+      pre.simplify();
+      pre.copyTo(T);
+      T.default_params = S.default_params;
+      T.verbosity = S.verbosity;
+      solver = &T;
+   }
+   Clock::time_point simp_time = Clock::now();
+
+   vec<Lit> assumps;
+   if (budget >= 0) solver->setConfBudget(budget);
+   lbool ret = solver->okay() ? solver->solveLimited(assumps) : l_False;
+   Clock::time_point solved_time = Clock::now();
+
+   cout << (ret == l_True ? "SATISFIABLE" : ret == l_False ? "UNSATISFIABLE" : "INDETERMINATE") << endl;
+   cout << "Variables    : " << S.nVars() << endl;
+   cout << "Clauses      : " << solver->nClauses() << (simp ? " (simplified)" : "") << endl;
+   if (simp) {
+      cout << "Eliminated   : " << pre.n_eliminated << " vars" << endl;
+      cout << "Substituted  : " << pre.n_substituted << " vars" << endl;
+      cout << "Subsumed     : " << pre.n_subsumed << " clauses" << endl;
+      cout << "Strengthened : " << pre.n_strengthened << " clauses" << endl;
+   }
+   cout << "Decisions    : " << solver->stats.decisions << endl;
+   cout << "Propagations : " << solver->stats.propagations << endl;
+   cout << "Conflicts    : " << solver->stats.conflicts << endl;
+   cout << fixed << setprecision(3);
+   cout << "Parse time   : " << chrono::duration<double>(parsed_time - start).count() << " s" << endl;
+   if (simp)
+      cout << "Simp time    : " << chrono::duration<double>(simp_time - parsed_time).count() << " s" << endl;
+   cout << "Solve time   : " << chrono::duration<double>(solved_time - simp_time).count() << " s" << endl;
+   return ret == l_True ? 10 : ret == l_False ? 20 : 0;
+}
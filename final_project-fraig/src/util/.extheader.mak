@@ -1,4 +1,4 @@
-util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../../include/myHash.h 
+util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../../include/myHash.h ../../include/myStats.h 
 ../../include/util.h: util.h
 	@rm -f ../../include/util.h
 	@ln -fs ../src/util/util.h ../../include/util.h
@@ -11,3 +11,6 @@ util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../..
 ../../include/myHash.h: myHash.h
 	@rm -f ../../include/myHash.h
 	@ln -fs ../src/util/myHash.h ../../include/myHash.h
+../../include/myStats.h: myStats.h
+	@rm -f ../../include/myStats.h
+	@ln -fs ../src/util/myStats.h ../../include/myStats.h
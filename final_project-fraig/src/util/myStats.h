@@ -0,0 +1,182 @@
+/****************************************************************************
+  FileName     [ myStats.h ]
+  PackageName  [ util ]
+  Synopsis     [ Event counters and phase timers of the cir and sat packages ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef MY_STATS_H
+#define MY_STATS_H
+
+#include <stdint.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// The counters are compiled only with -DMY_STATS (the debug CFLAGS in
+// src/Makefile.in); otherwise STAT_ADD, STAT_TIMER and STAT_FEC expand to
+// nothing and no code of this file is called.
+
+enum StatCounter
+{
+   STAT_DFS_CALLS,      // CirMgr::get_dfs_list calls
+   STAT_DFS_GATES,      // gates visited by them
+   STAT_STRASH_PROBES,  // structural hash lookups
+   STAT_SIM_WORDS,      // 64-bit gate words simulated
+   STAT_SAT_SAT,        // solve calls by result
+   STAT_SAT_UNSAT,
+   STAT_SAT_UNDEF,
+
+   STAT_COUNTER_TOT
+};
+
+class MyStats
+{
+   typedef chrono::steady_clock Clock;
+
+public:
+   MyStats() { reset(); }
+
+   void reset() {
+      for (int i = 0; i < STAT_COUNTER_TOT; ++i) _counters[i] = 0;
+      _phases.clear();
+      _fecSamples.clear();
+      _fecStride = 1; _fecSkip = 0;
+      _start = Clock::now();
+   }
+
+   // may be called by several threads
+   void add(StatCounter c, int64_t n) {
+      _counters[c].fetch_add(n, memory_order_relaxed);
+   }
+   // called from the main thread only; nested phases are counted in both
+   void addTime(const char* name, double sec) {
+      for (size_t i = 0, n = _phases.size(); i < n; ++i)
+         if (_phases[i].name == name) {
+            ++_phases[i].calls; _phases[i].seconds += sec; return;
+         }
+      _phases.push_back(Phase(name, sec));
+   }
+   // the FEC groups over time, a pair is a gate and its representative;
+   // at most FEC_SAMPLE_MAX samples are kept, every other one is dropped
+   // (and the stride doubled) when it is full
+   template <class Groups>
+   void sampleFec(const Groups& groups) {
+      if (_fecSkip++ % _fecStride) return;
+      size_t pairs = 0;
+      for (size_t i = 0, n = groups.size(); i < n; ++i)
+         pairs += groups[i].size() - 1;
+      if (_fecSamples.size() == FEC_SAMPLE_MAX) {
+         for (size_t i = 0; i < FEC_SAMPLE_MAX / 2; ++i)
+            _fecSamples[i] = _fecSamples[i * 2];
+         _fecSamples.erase(_fecSamples.begin() + FEC_SAMPLE_MAX / 2, _fecSamples.end());
+         _fecStride *= 2;
+      }
+      _fecSamples.push_back(FecSample(elapsed(), groups.size(), pairs));
+   }
+
+   void report(ostream& os) const {
+      os << endl << "Counters" << endl << "==================" << endl;
+      for (int i = 0; i < STAT_COUNTER_TOT; ++i)
+         os << "  " << setw(14) << left << counterName(i)
+            << setw(14) << right << _counters[i] << endl;
+      os << endl << "Phases                calls    time (s)" << endl
+         << "==================" << endl;
+      for (size_t i = 0, n = _phases.size(); i < n; ++i)
+         os << "  " << setw(14) << left << _phases[i].name << setw(11) << right
+            << _phases[i].calls << setw(12) << fixed << setprecision(3)
+            << _phases[i].seconds << endl;
+      os << endl << "FEC groups        time (s)    groups     pairs" << endl
+         << "==================" << endl;
+      for (size_t i = 0, n = _fecSamples.size(); i < n; ++i)
+         os << "  " << setw(24) << right << fixed << setprecision(3)
+            << _fecSamples[i].time << setw(10) << _fecSamples[i].groups
+            << setw(10) << _fecSamples[i].pairs << endl;
+      os.unsetf(ios::fixed);
+   }
+   void reportJson(ostream& os) const {
+      os << "{" << endl << "  \"counters\": {";
+      for (int i = 0; i < STAT_COUNTER_TOT; ++i)
+         os << (i ? ", " : " ") << "\"" << counterName(i) << "\": " << _counters[i];
+      os << " }," << endl << "  \"phases\": [";
+      for (size_t i = 0, n = _phases.size(); i < n; ++i)
+         os << (i ? ",\n    " : "\n    ") << "{ \"name\": \"" << _phases[i].name
+            << "\", \"calls\": " << _phases[i].calls << ", \"seconds\": "
+            << _phases[i].seconds << " }";
+      os << "\n  ]," << endl << "  \"fec\": [";
+      for (size_t i = 0, n = _fecSamples.size(); i < n; ++i)
+         os << (i ? ",\n    " : "\n    ") << "{ \"seconds\": " << _fecSamples[i].time
+            << ", \"groups\": " << _fecSamples[i].groups << ", \"pairs\": "
+            << _fecSamples[i].pairs << " }";
+      os << "\n  ]" << endl << "}" << endl;
+   }
+
+private:
+   struct Phase {
+      Phase(const char* n, double s): name(n), calls(1), seconds(s) { }
+      string   name;
+      int64_t  calls;
+      double   seconds;
+   };
+   struct FecSample {
+      FecSample(double t, size_t g, size_t p): time(t), groups(g), pairs(p) { }
+      double   time;     // seconds since reset()
+      size_t   groups, pairs;
+   };
+   static const size_t FEC_SAMPLE_MAX = 1024;
+
+   atomic<int64_t>    _counters[STAT_COUNTER_TOT];
+   vector<Phase>      _phases;
+   vector<FecSample>  _fecSamples;
+   size_t             _fecStride, _fecSkip;
+   Clock::time_point  _start;
+
+   double elapsed() const {
+      return chrono::duration<double>(Clock::now() - _start).count();
+   }
+   static const char* counterName(int c) {
+      static const char* names[STAT_COUNTER_TOT] = {
+         "dfs_calls", "dfs_gates", "strash_probes", "sim_words",
+         "sat_sat", "sat_unsat", "sat_undef" };
+      return names[c];
+   }
+};
+
+// Adds the elapsed time of its scope to a phase
+class MyStatTimer
+{
+public:
+   MyStatTimer(const char* name): _name(name), _start(chrono::steady_clock::now()) { }
+   ~MyStatTimer();
+
+private:
+   const char*                          _name;
+   chrono::steady_clock::time_point     _start;
+};
+
+extern MyStats myStats;  // defined in util.cpp with -DMY_STATS
+
+inline MyStatTimer::~MyStatTimer()
+{
+   myStats.addTime(_name, chrono::duration<double>(chrono::steady_clock::now() - _start).count());
+}
+
+#define STAT_CONCAT2(a, b) a ## b
+#define STAT_CONCAT(a, b) STAT_CONCAT2(a, b)
+#ifdef MY_STATS
+#define STAT_ADD(c, n) myStats.add(c, (n))
+#define STAT_TIMER(name) MyStatTimer STAT_CONCAT(_statTimer, __LINE__)(name)
+#define STAT_FEC(groups) myStats.sampleFec(groups)
+#else
+#define STAT_ADD(c, n) ((void)0)
+#define STAT_TIMER(name) ((void)0)
+#define STAT_FEC(groups) ((void)0)
+#endif
+
+#endif // MY_STATS_H
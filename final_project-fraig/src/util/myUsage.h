@@ -48,6 +48,9 @@ public:
       }
    }
 
+   // peak resident set size of the process (in MB)
+   double getPeakMem() const { return checkMem(); }
+
 private:
    // for Memory usage (in MB)
    double     _initMem;
@@ -10,21 +10,77 @@
 
 #include <unistd.h>
 #include <sys/types.h>
-#include <stdlib.h>  
-#include <limits.h>
-
-#define my_srandom  srandom
-#define my_random   random
+#include <stdint.h>
 
+// xoshiro256** (Blackman and Vigna): full 64-bit words from 256 bits of state,
+// seeded by splitmix64. "jump()" advances 2^128 words, so generators made with
+// the same seed and different "stream" numbers (e.g. one per thread) never overlap.
 class RandomNumGen
 {
    public:
-      RandomNumGen() { my_srandom(getpid()); }
-      RandomNumGen(unsigned seed) { my_srandom(seed); }
-      const int operator() (const int range) const {
-         return int(range * (double(my_random()) / INT_MAX));
+      RandomNumGen() { seed(getpid()); }
+      RandomNumGen(unsigned s, unsigned stream = 0) {
+         seed(s);
+         for (unsigned i = 0; i < stream; ++i) jump();
+      }
+
+      void seed(uint64_t s) {
+         for (int i = 0; i < 4; ++i) {
+            uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            _s[i] = z ^ (z >> 31);
+         }
+      }
+      // a random word
+      uint64_t next() {
+         uint64_t s0 = _s[0], s1 = _s[1], s2 = _s[2], s3 = _s[3];
+         uint64_t ret = rotl(s1 * 5, 7) * 9;
+         step(s0, s1, s2, s3);
+         _s[0] = s0; _s[1] = s1; _s[2] = s2; _s[3] = s3;
+         return ret;
+      }
+      // [0, range), from the high 32 bits without division
+      int operator() (const int range) {
+         return int(((next() >> 32) * uint64_t(range)) >> 32);
+      }
+      // a random word in every element of [first, last); the state stays in
+      // registers for the whole range
+      template <class Iter>
+      void fill(Iter first, Iter last) {
+         uint64_t s0 = _s[0], s1 = _s[1], s2 = _s[2], s3 = _s[3];
+         for (; first != last; ++first) {
+            *first = rotl(s1 * 5, 7) * 9;
+            step(s0, s1, s2, s3);
+         }
+         _s[0] = s0; _s[1] = s1; _s[2] = s2; _s[3] = s3;
+      }
+      // equivalent to 2^128 calls of "next()"
+      void jump() {
+         static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                          0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+         uint64_t t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+         for (int i = 0; i < 4; ++i)
+            for (int b = 0; b < 64; ++b) {
+               if (JUMP[i] & (uint64_t(1) << b)) {
+                  t0 ^= _s[0]; t1 ^= _s[1]; t2 ^= _s[2]; t3 ^= _s[3];
+               }
+               next();
+            }
+         _s[0] = t0; _s[1] = t1; _s[2] = t2; _s[3] = t3;
+      }
+
+   private:
+      uint64_t _s[4];
+
+      static inline uint64_t rotl(uint64_t x, int k) {
+         return (x << k) | (x >> (64 - k));
+      }
+      static inline void step(uint64_t& s0, uint64_t& s1, uint64_t& s2, uint64_t& s3) {
+         uint64_t t = s1 << 17;
+         s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+         s2 ^= t; s3 = rotl(s3, 45);
       }
 };
 
 #endif // RN_GEN_H
-
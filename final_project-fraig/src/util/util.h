@@ -12,6 +12,7 @@
 #include <vector>
 #include "rnGen.h"
 #include "myUsage.h"
+#include "myStats.h"
 
 using namespace std;
 